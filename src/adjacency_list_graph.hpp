@@ -6,8 +6,10 @@
 #include <array>
 #include <iterator>
 #include <memory>
+#include <tuple>
 
 #include "graph.hpp"
+#include "object_pool.hpp"
 
 #ifndef _alg_vertex_ptr
 #define _alg_vertex_ptr static_cast<AdjacencyListVertex<T,W>*>
@@ -80,7 +82,7 @@ struct AdjacencyListEdge : Edge<T,W>
     /// @brief Konstruktor kopiujacy.
     /// @param other obiekt do skopiowania
     AdjacencyListEdge(const AdjacencyListEdge<T,W>& other):
-        Edge<T,W>(other), iteratorIv{other.iteratorIv}, iteratorIw{other.iteratorIw} {}
+        Edge<T,W>(other), positionIv{other.positionIv}, positionIw{other.positionIw} {}
 
     /// @brief Przeciazenie operatora kopiujacego-przypisywania
     /// @param other obiekt do skopiowania
@@ -90,26 +92,38 @@ struct AdjacencyListEdge : Edge<T,W>
         if (this == &other)
             return *this;
         Edge<T,W>::operator=(other);
-        iteratorIv = other.iteratorIv;
-        iteratorIw = other.iteratorIw;
+        positionIv = other.positionIv;
+        positionIw = other.positionIw;
         return *this;
     }
 
-    // Iteratory w strukturze krawedzi incydentnych.
+    // Pozycje w strukturach krawedzi incydentnych wierzcholkow v i w.
 
-    typename std::vector<Edge<T, W>*>::iterator iteratorIv;
-    typename std::vector<Edge<T, W>*>::iterator iteratorIw;
+    sizeType positionIv;
+    sizeType positionIw;
 };
 
 template <typename T, typename W>
 class AdjacencyListGraph : public GraphADT<T,W>
 {
     public:
-        /// @brief "Czysci" graf. Wynikiem dzialania jest pusta struktura.
+        AdjacencyListGraph() = default;
+        AdjacencyListGraph(const AdjacencyListGraph<T,W>&) = delete;
+        AdjacencyListGraph<T,W>& operator=(const AdjacencyListGraph<T,W>&) = delete;
+
+        ~AdjacencyListGraph()
+            { clear(); }
+
+        /// @brief "Czysci" graf. Wynikiem dzialania jest pusta struktura. Obiekty wierzcholkow i krawedzi
+        /// zwalniane sa zbiorczo, a pamiec pul pozostaje do ponownego uzycia.
         void clear()
         {
+            TRACE_SPAN("AdjacencyListGraph::clear");
+            Vpool.release(V);
+            Epool.release(E);
             V.clear();
             E.clear();
+            this->notifyCleared();
         }
 
         /// @return Zwraca rozmiar struktury przechowujacej wierzcholki.
@@ -166,20 +180,25 @@ class AdjacencyListGraph : public GraphADT<T,W>
         /// @param e referencja do krawedzi w grafie
         /// @param x nowa wartosc
         void replace(Edge<T,W>* const e, const W& x)
-            { e->element = x; }
+        {
+            const W previous = e->element;
+            e->element = x;
+            this->notifyEdgeReplaced(e, previous);
+        }
 
         /// @brief Dodaje wierzcholek do grafu.
         /// @param x wartosc przechowywana na wierzcholku
         /// @return Zwraca referencje do nowo utworzonego wierzcholka.
         Vertex<T,W>* insertVertex(const T& x)
         {
-            V.push_back(std::unique_ptr<Vertex<T,W>>(new AdjacencyListVertex<T,W>(x)));
+            V.push_back(Vpool.create(x));
             // typename VlistType::iterator last = --(V.end());
-            // V.back().get()->iterator = last;
+            // V.back()->iterator = last;
             sizeType last = V.size() - 1;
-            V.back().get()->i = last;
-            // return (*last).get();
-            return V[last].get();
+            V.back()->i = last;
+            this->notifyVertexInserted(V[last]);
+            // return (*last);
+            return V[last];
         }
 
         /// @brief Dodaje krawedz do grafu.
@@ -189,94 +208,166 @@ class AdjacencyListGraph : public GraphADT<T,W>
         /// @return Zwraca referencje do nowo utworzonej krawedzi.
         Edge<T,W>* insertEdge(Vertex<T,W>* v, Vertex<T,W>* w, const W& x)
         {
-            E.push_back(std::unique_ptr<Edge<T,W>>(new AdjacencyListEdge<T,W>(v, w, x)));
+            E.push_back(Epool.create(v, w, x));
             // typename ElistType::iterator last = --(E.end());
             sizeType last = E.size() - 1;
 
-            AdjacencyListEdge<T,W>* edge = static_cast<AdjacencyListEdge<T,W>*>(E.back().get());
+            AdjacencyListEdge<T,W>* edge = static_cast<AdjacencyListEdge<T,W>*>(E.back());
             // edge->iterator = last;
             edge->i = last;
 
+            edge->positionIv = _alg_vertex_ptr(edge->v)->I.size();
             _alg_vertex_ptr(edge->v)->I.push_back(edge);
-            edge->iteratorIv = --(_alg_vertex_ptr(edge->v)->I.end());
 
+            edge->positionIw = _alg_vertex_ptr(edge->w)->I.size();
             _alg_vertex_ptr(edge->w)->I.push_back(edge);
-            edge->iteratorIw = --(_alg_vertex_ptr(edge->w)->I.end());
 
-            // return (*last).get();
-            return E[last].get();
+            this->notifyEdgeInserted(edge);
+            // return (*last);
+            return E[last];
+        }
+
+        /// @brief Rezerwuje miejsce w tablicach i pulach na podana liczbe wierzcholkow i krawedzi.
+        /// @param verticesNumber docelowa liczba wierzcholkow
+        /// @param edgesNumber docelowa liczba krawedzi
+        void reserve(const sizeType& verticesNumber, const sizeType& edgesNumber)
+        {
+            if (verticesNumber > V.size())
+            {
+                V.reserve(verticesNumber);
+                Vpool.reserve(verticesNumber - V.size());
+            }
+            if (edgesNumber > E.size())
+            {
+                E.reserve(edgesNumber);
+                Epool.reserve(edgesNumber - E.size());
+            }
+        }
+
+        /// @brief Dodaje zbior krawedzi w dwoch przejsciach: najpierw zliczane sa stopnie wierzcholkow, aby kazda
+        /// lista krawedzi incydentnych zostala zaalokowana jeden raz, a nastepnie krawedzie sa rozmieszczane.
+        /// @param edges krawedzie miedzy istniejacymi wierzcholkami
+        void insertEdges(const typename GraphADT<T,W>::EdgeList& edges)
+        {
+            TRACE_SPAN("AdjacencyListGraph::insertEdges");
+            reserve(V.size(), E.size() + edges.size());
+
+            std::vector<sizeType> degree(V.size(), 0);
+            for (auto & e : edges)
+            {
+                degree[std::get<0>(e)]++;
+                degree[std::get<1>(e)]++;
+            }
+            for (sizeType i = 0; i < V.size(); i++)
+                if (degree[i])
+                    _alg_vertex_ptr(V[i])->I.reserve(_alg_vertex_ptr(V[i])->I.size() + degree[i]);
+
+            for (auto & e : edges)
+                AdjacencyListGraph<T,W>::insertEdge(V[std::get<0>(e)], V[std::get<1>(e)], std::get<2>(e));
         }
 
-        /// @brief Usuwa wierzcholek z grafu.
+        /// @brief Usuwa wierzcholek z grafu w czasie proporcjonalnym do jego stopnia.
+        /// Ostatni wierzcholek przejmuje indeks usunietego.
         /// @param v referencja do wierzcholka w grafie
         void removeVertex(Vertex<T,W>* const v)
         {
+            TRACE_SPAN("AdjacencyListGraph::removeVertex");
             // Usuwanie krawędzi incydentnych
-            for (auto & i : _alg_cvertex_cptr(v)->I)
-                removeEdge(i);
-
-            // Porzadkowanie indeksow
-            sizeType* newIndex = &v->i;
-            for (sizeType i = v->i; i < V.size(); i++)
-                std::swap(*newIndex, V[i].get()->i);
-
-            // Usuwanie wpisu wierchołka z listy wierzchołków
-            // V.erase(v->iterator);
-            V.erase(V.begin() + v->i);
+            const std::vector<Edge<T,W>*>& I = _alg_cvertex_cptr(v)->I;
+            while (!I.empty())
+                removeEdge(I.back());
+
+            // Przeniesienie ostatniego wierzcholka na miejsce usuwanego
+            const sizeType k = v->i;
+            const sizeType moved = V.size() - 1;
+            V[k] = V.back();
+            V[k]->i = k;
+            V.pop_back();
+            Vpool.destroy(_alg_vertex_cptr(v));
+            this->notifyVertexRemoved(k, moved);
         }
 
-        /// @brief Usuwa krawedz z grafu
+        /// @brief Usuwa krawedz z grafu w czasie stalym. Ostatnia krawedz przejmuje indeks usunietej.
         /// @param e referencja do krawedzi w grafie
         void removeEdge(Edge<T,W>* const e)
         {
-            _alg_vertex_ptr(e->v)->I.erase(_alg_edge_cptr(e)->iteratorIv);
-            _alg_vertex_ptr(e->w)->I.erase(_alg_edge_cptr(e)->iteratorIw);
-
-            // Porzadkowanie indeksow
-            sizeType* newIndex = &e->i;
-            for (sizeType i = e->i; i < V.size(); i++)
-                std::swap(*newIndex, E[i].get()->i);
-
-            // E.erase(e->iterator);
-            E.erase(E.begin() + e->i);
+            AdjacencyListEdge<T,W>* const edge = _alg_edge_cptr(e);
+            Vertex<T,W>* const v = edge->v;
+            Vertex<T,W>* const w = edge->w;
+            const W x = edge->element;
+            detach(_alg_vertex_ptr(edge->v), edge->positionIv);
+            detach(_alg_vertex_ptr(edge->w), edge->positionIw);
+
+            // Przeniesienie ostatniej krawedzi na miejsce usuwanej
+            const sizeType k = e->i;
+            E[k] = E.back();
+            E[k]->i = k;
+            E.pop_back();
+            Epool.destroy(edge);
+            this->notifyEdgeRemoved(v, w, x);
         }
 
         /// @param v referencja do wierzcholka w grafie
         /// @return Zwraca std::vector przechowujacy referencje do krawedzi incydentnych.
         std::vector<Edge<T,W>*> incidentEdges(const Vertex<T,W>* const v) const
-        {
-            std::vector<Edge<T,W>*> vect;
-            for (auto & i : _alg_cvertex_cptr(v)->I)
-                vect.push_back(i);
-            return vect;
-        }
+            { return _alg_cvertex_cptr(v)->I; }
         
         /// @return Zwraca std::vector przechowujacy referencje do wszystkich wierzcholkow w grafie.
         std::vector<Vertex<T,W>*> vertices() const
-        {
-            std::vector<Vertex<T,W>*> vect;
-            for (auto & i : V)
-                vect.push_back(i.get());
-            return vect;
-        }
+            { return V; }
 
         /// @return Zwraca std::vector przechowujacy referencje do wszystkich krawedzi w grafie.
         std::vector<Edge<T,W>*> edges() const
+            { return E; }
+
+        /// @brief Wersja incidentEdges bez alokacji pamieci.
+        /// @param v referencja do wierzcholka w grafie
+        /// @return Zwraca zakres krawedzi incydentnych, wazny do nastepnej modyfikacji grafu.
+        EdgeRange<T,W> incidentEdgesRange(const Vertex<T,W>* const v) const
         {
-            std::vector<Edge<T,W>*> vect;
-            for (auto & i : E)
-                vect.push_back(i.get());
-            return vect;
+            const std::vector<Edge<T,W>*>& I = _alg_cvertex_cptr(v)->I;
+            return EdgeRange<T,W>(I.data(), I.data() + I.size());
         }
 
+        /// @param i indeks wierzcholka (Vertex::i)
+        /// @return Zwraca referencje do wierzcholka o danym indeksie.
+        Vertex<T,W>* vertex(const sizeType& i) const
+            { return V[i]; }
+
+        /// @param i indeks krawedzi (Edge::i)
+        /// @return Zwraca referencje do krawedzi o danym indeksie.
+        Edge<T,W>* edge(const sizeType& i) const
+            { return E[i]; }
+
     private:
+        /// @brief Usuwa wpis z krawedzi incydentnych wierzcholka, przenoszac na jego miejsce ostatni wpis.
+        /// @param x wierzcholek koncowy usuwanej krawedzi
+        /// @param position pozycja usuwanego wpisu w x->I
+        static void detach(AdjacencyListVertex<T,W>* x, const sizeType& position)
+        {
+            std::vector<Edge<T,W>*>& I = x->I;
+            AdjacencyListEdge<T,W>* moved = _alg_edge_cptr(I.back());
+            I[position] = moved;
+            I.pop_back();
+            if (position == I.size())
+                return;
+            if (moved->v == x)
+                moved->positionIv = position;
+            else
+                moved->positionIw = position;
+        }
+
         // typedef std::list<std::unique_ptr<Vertex<T,W>>> VlistType;
         // typedef std::list<std::unique_ptr<Edge<T,W>>> ElistType;
-        typedef std::vector<std::unique_ptr<Vertex<T,W>>> VlistType;
-        typedef std::vector<std::unique_ptr<Edge<T,W>>> ElistType;
+        typedef std::vector<Vertex<T,W>*> VlistType;
+        typedef std::vector<Edge<T,W>*> ElistType;
 
         VlistType V;
         ElistType E;
+
+        // Pule przechowujace obiekty wierzcholkow i krawedzi
+        ObjectPool<AdjacencyListVertex<T,W>> Vpool;
+        ObjectPool<AdjacencyListEdge<T,W>> Epool;
 };
 
 #endif
\ No newline at end of file
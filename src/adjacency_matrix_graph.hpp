@@ -3,11 +3,16 @@
 
 #include <vector>
 #include <list>
+#include <algorithm>
 #include <array>
 #include <iterator>
 #include <memory>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
 
 #include "graph.hpp"
+#include "object_pool.hpp"
 
 #ifndef _amg_vertex_ptr
 #define _amg_vertex_ptr static_cast<AdjacencyMatrixVertex<T,W>*>
@@ -90,18 +95,37 @@ struct AdjacencyMatrixEdge : public Edge<T,W>
 };
 
 /// @brief Klasa implementujaca graf w reprezentacji macierzy sasiadow.
+/// Macierz przechowywana jest w jednym ciaglym buforze wierszowym o rozmiarze stride x stride,
+/// ktorego pojemnosc rosnie dwukrotnie przy przepelnieniu.
 /// @tparam T typ danych na wierzcholkach grafu
 /// @tparam W typ danych na krawedziach grafu
-template <typename T, typename W>
+/// @tparam C typ komorki macierzy: Edge<T,W>* (domyslnie) albo std::uint32_t (indeks krawedzi + 1, polowa pamieci)
+template <typename T, typename W, typename C = Edge<T,W>*>
 class AdjacencyMatrixGraph : public GraphADT<T,W>
 {
+    static_assert(std::is_same<C, Edge<T,W>*>::value || std::is_same<C, std::uint32_t>::value,
+                  "Komorka macierzy musi byc typu Edge<T,W>* albo std::uint32_t");
+
     public:
-        /// @brief "Czysci" graf. Wynikiem dzialania jest pusta struktura.
+        AdjacencyMatrixGraph() = default;
+        AdjacencyMatrixGraph(const AdjacencyMatrixGraph<T,W,C>&) = delete;
+        AdjacencyMatrixGraph<T,W,C>& operator=(const AdjacencyMatrixGraph<T,W,C>&) = delete;
+
+        ~AdjacencyMatrixGraph()
+            { clear(); }
+
+        /// @brief "Czysci" graf. Wynikiem dzialania jest pusta struktura. Obiekty wierzcholkow i krawedzi
+        /// zwalniane sa zbiorczo, a pamiec pul pozostaje do ponownego uzycia.
         void clear()
         {
+            TRACE_SPAN("AdjacencyMatrixGraph::clear");
+            Vpool.release(V);
+            Epool.release(E);
             V.clear();
             E.clear();
             A.clear();
+            stride = 0;
+            this->notifyCleared();
         }
 
         /// @return Zwraca rozmiar struktury przechowujacej wierzcholki.
@@ -128,13 +152,9 @@ class AdjacencyMatrixGraph : public GraphADT<T,W>
         /// @brief Sprawdza czy dane wierzcholki sa sasiednie.
         /// @param v referencja do pierwszego wierzcholka w grafie
         /// @param w referencja do drugiego wierzcholka w grafie
-        /// @return Zwraca prawde jezeli wierzcholki sa sasiednie. W przec
+        /// @return Zwraca prawde jezeli wierzcholki sa sasiednie. W przeciwnym wypadku falsz.
         bool areAdjacent(const Vertex<T,W>* v, const Vertex<T,W>* w) const
-        {
-            if (A[_amg_cvertex_ptr(v)->Aindex][_amg_cvertex_ptr(w)->Aindex]) 
-                return true;
-            return false;
-        }
+            { return cell(_amg_cvertex_ptr(v)->Aindex, _amg_cvertex_ptr(w)->Aindex) != C(); }
 
         /// @brief Modyfikuje wartosc na wierzcholku.
         /// @param v referencja do wierzcholka w grafie
@@ -146,24 +166,25 @@ class AdjacencyMatrixGraph : public GraphADT<T,W>
         /// @param e referencja do krawedzi w grafie
         /// @param x nowa wartosc
         void replace(Edge<T,W>* const e, const W& x)
-            { e->element = x; }
+        {
+            const W previous = e->element;
+            e->element = x;
+            this->notifyEdgeReplaced(e, previous);
+        }
 
         /// @brief Dodaje wierzcholek do grafu.
         /// @param x wartosc przechowywana na wierzcholku
         /// @return Zwraca referencje do nowo utworzonego wierzcholka.
         Vertex<T,W>* insertVertex(const T& x)
         {
-            V.push_back(std::unique_ptr<Vertex<T,W>>(new AdjacencyListVertex<T,W>(x)));
-            // typename VlistType::iterator last = --(V.end());
-            // V.back().get()->iterator = last;
+            V.push_back(Vpool.create(x));
             sizeType last = V.size() - 1;
-            V.back().get()->i = last;
-            for (int i = 0; i < A.size(); i++)
-                A[i].push_back(nullptr);
-            _amg_vertex_ptr(V.back().get())->Aindex = A.size();
-            A.push_back(std::vector<Edge<T,W>*>(A.size() + 1, nullptr));
-            // return (*last).get();
-            return V[last].get();
+            V.back()->i = last;
+            if (last == stride)
+                grow(stride ? 2 * stride : 1, last);
+            _amg_vertex_ptr(V.back())->Aindex = last;
+            this->notifyVertexInserted(V[last]);
+            return V[last];
         }
 
         /// @brief Dodaje krawedz do grafu.
@@ -173,62 +194,97 @@ class AdjacencyMatrixGraph : public GraphADT<T,W>
         /// @return Zwraca referencje do nowo utworzonej krawedzi.
         Edge<T,W>* insertEdge(Vertex<T,W>* v, Vertex<T,W>* w, const W& x)
         {
-            E.push_back(std::unique_ptr<Edge<T,W>>(new AdjacencyListEdge<T,W>(v, w, x)));
-            // typename ElistType::iterator last = --(E.end());
-            // E.back().get()->iterator = last;
+            E.push_back(Epool.create(v, w, x));
             sizeType last = E.size() - 1;
-            E.back().get()->i = last;
-            A[_amg_vertex_ptr(v)->Aindex][_amg_vertex_ptr(w)->Aindex] = E.back().get();
-            A[_amg_vertex_ptr(w)->Aindex][_amg_vertex_ptr(v)->Aindex] = E.back().get();
-            //  return (*last).get();
-             return E[last].get();
+            E.back()->i = last;
+            setCells(E.back(), encode(E.back()));
+            this->notifyEdgeInserted(E[last]);
+            return E[last];
         }
 
-        /// @brief Usuwa wierzcholek z grafu.
-        /// @param v referencja do wierzcholka w grafie
-        void removeVertex(Vertex<T,W>* const v)
+        /// @brief Rezerwuje miejsce w tablicach i pulach oraz powieksza macierz do docelowej liczby wierzcholkow,
+        /// aby kolejne wstawienia nie przepisywaly jej przy kazdym podwojeniu.
+        /// @param verticesNumber docelowa liczba wierzcholkow
+        /// @param edgesNumber docelowa liczba krawedzi
+        void reserve(const sizeType& verticesNumber, const sizeType& edgesNumber)
         {
-            AdjacencyMatrixVertex<T,W>* const vAM = _amg_vertex_cptr(v);
-
-            // Porzadkowanie indeksow
-            sizeType* newIndex = &vAM->Aindex;
-            // for (auto & i = ++(v->iterator); i != V.end(); i++)
-            //     std::swap(*newIndex, _amg_vertex_ptr(i->get())->Aindex);
-            for (sizeType i = v->i; i < V.size(); i++)
+            if (verticesNumber > V.size())
             {
-                std::swap(*newIndex, _amg_vertex_ptr(V[i].get())->Aindex);
-                std::swap(*newIndex, V[i].get()->i);
+                V.reserve(verticesNumber);
+                Vpool.reserve(verticesNumber - V.size());
             }
+            if (verticesNumber > stride)
+                grow(verticesNumber, V.size());
+            if (edgesNumber > E.size())
+            {
+                E.reserve(edgesNumber);
+                Epool.reserve(edgesNumber - E.size());
+            }
+        }
 
-            // Usuwanie wpisow krawedzi incydentnych z listy krawedzi
-            for (auto & i : A[vAM->Aindex])
-                // if (i) E.erase(i->iterator);
-                if (i) E.erase(E.begin() + i->i);
+        /// @brief Dodaje zbior krawedzi; pamiec i macierz rezerwowane sa jednorazowo.
+        /// @param edges krawedzie miedzy istniejacymi wierzcholkami
+        void insertEdges(const typename GraphADT<T,W>::EdgeList& edges)
+        {
+            TRACE_SPAN("AdjacencyMatrixGraph::insertEdges");
+            reserve(V.size(), E.size() + edges.size());
+            for (auto & e : edges)
+                AdjacencyMatrixGraph<T,W,C>::insertEdge(V[std::get<0>(e)], V[std::get<1>(e)], std::get<2>(e));
+        }
 
-            // Czyszczenie macierzy
-            A.erase(A.begin() + vAM->Aindex);
-            for (auto & i : A)
-                i.erase(i.begin() + vAM->Aindex);
+        /// @brief Usuwa wierzcholek z grafu w czasie O(V). Ostatni wierzcholek przejmuje indeks
+        /// oraz wiersz i kolumne macierzy usunietego.
+        /// @param v referencja do wierzcholka w grafie
+        void removeVertex(Vertex<T,W>* const v)
+        {
+            TRACE_SPAN("AdjacencyMatrixGraph::removeVertex");
+            const sizeType k = _amg_vertex_cptr(v)->Aindex;
+            const sizeType last = V.size() - 1;
+
+            // Usuwanie krawedzi incydentnych
+            for (sizeType j = 0; j <= last; j++)
+                if (cell(k, j) != C())
+                    removeEdge(decode(cell(k, j)));
+
+            // Przeniesienie wiersza i kolumny ostatniego wierzcholka. Komorki (last, k) i (k, last) sa juz puste.
+            for (sizeType j = 0; j <= last; j++)
+                A[k * stride + j] = A[last * stride + j];
+            for (sizeType j = 0; j <= last; j++)
+                A[j * stride + k] = A[j * stride + last];
+            for (sizeType j = 0; j <= last; j++)
+            {
+                A[last * stride + j] = C();
+                A[j * stride + last] = C();
+            }
 
-            // Usuwanie wpisu wierzcholka z listy wierzcholkow
-            // V.erase(--(v->iterator));
-            V.erase(V.begin() + v->i);
+            // Przeniesienie ostatniego wierzcholka na miejsce usuwanego
+            V[k] = V.back();
+            V[k]->i = k;
+            _amg_vertex_ptr(V[k])->Aindex = k;
+            V.pop_back();
+            Vpool.destroy(_amg_vertex_cptr(v));
+            this->notifyVertexRemoved(k, last);
         }
 
-        /// @brief Usuwa krawedz z grafu
+        /// @brief Usuwa krawedz z grafu w czasie stalym. Ostatnia krawedz przejmuje indeks usunietej.
         /// @param e referencja do krawedzi w grafie
         void removeEdge(Edge<T,W>* const e)
         {
-            A[_amg_vertex_cptr(e->v)->Aindex][_amg_vertex_cptr(e->w)->Aindex] = nullptr;
-            A[_amg_vertex_cptr(e->w)->Aindex][_amg_vertex_cptr(e->v)->Aindex] = nullptr;
-
-            // Porzadkowanie indeksow
-            sizeType* newIndex = &e->i;
-            for (sizeType i = e->i; i < V.size(); i++)
-                std::swap(*newIndex, E[i].get()->i);
-
-            // E.erase(e->iterator);
-            E.erase(E.begin() + e->i);
+            Vertex<T,W>* const v = e->v;
+            Vertex<T,W>* const w = e->w;
+            const W x = e->element;
+            setCells(e, C());
+
+            // Przeniesienie ostatniej krawedzi na miejsce usuwanej
+            const sizeType k = e->i;
+            E[k] = E.back();
+            E[k]->i = k;
+            E.pop_back();
+            if constexpr (std::is_same<C, std::uint32_t>::value)
+                if (k < E.size())
+                    setCells(E[k], encode(E[k]));
+            Epool.destroy(static_cast<AdjacencyMatrixEdge<T,W>*>(e));
+            this->notifyEdgeRemoved(v, w, x);
         }
 
         /// @param v referencja do wierzcholka w grafie
@@ -236,38 +292,113 @@ class AdjacencyMatrixGraph : public GraphADT<T,W>
         std::vector<Edge<T,W>*> incidentEdges(const Vertex<T,W>* const v) const
         {
             std::vector<Edge<T,W>*> vect;
-            for (auto & i : A[_amg_cvertex_cptr(v)->Aindex])
-                if (i) vect.push_back(i);
+            for (auto i : incidentEdgesRange(v))
+                vect.push_back(i);
             return vect;
         }
         
         /// @return Zwraca std::vector przechowujacy referencje do wszystkich wierzcholkow w grafie.
         std::vector<Vertex<T,W>*> vertices() const
-        {
-            std::vector<Vertex<T,W>*> vect;
-            for (auto & i : V)
-                vect.push_back(i.get());
-            return vect;
-        }
+            { return V; }
 
         /// @return Zwraca std::vector przechowujacy referencje do wszystkich krawedzi w grafie.
         std::vector<Edge<T,W>*> edges() const
+            { return E; }
+
+        /// @brief Wersja incidentEdges bez alokacji pamieci.
+        /// @param v referencja do wierzcholka w grafie
+        /// @return Zwraca zakres krawedzi incydentnych, wazny do nastepnej modyfikacji grafu.
+        EdgeRange<T,W> incidentEdgesRange(const Vertex<T,W>* const v) const
         {
-            std::vector<Edge<T,W>*> vect;
-            for (auto & i : E)
-                vect.push_back(i.get());
-            return vect;
+            const C* row = A.data() + _amg_cvertex_cptr(v)->Aindex * stride;
+            if constexpr (std::is_same<C, std::uint32_t>::value)
+                return EdgeRange<T,W>(row, row + V.size(), E.data());
+            else
+                return EdgeRange<T,W>(row, row + V.size());
         }
 
+        /// @param i indeks wierzcholka (Vertex::i)
+        /// @return Zwraca referencje do wierzcholka o danym indeksie.
+        Vertex<T,W>* vertex(const sizeType& i) const
+            { return V[i]; }
+
+        /// @param i indeks krawedzi (Edge::i)
+        /// @return Zwraca referencje do krawedzi o danym indeksie.
+        Edge<T,W>* edge(const sizeType& i) const
+            { return E[i]; }
+
+        /// @return Zwraca prawde - przeglad wiersza macierzy kosztuje O(V).
+        bool denseStorage() const
+            { return true; }
+
     private:
-        // typedef std::list<std::unique_ptr<Vertex<T,W>>> VlistType;
-        // typedef std::list<std::unique_ptr<Edge<T,W>>> ElistType;
-        typedef std::vector<std::unique_ptr<Vertex<T,W>>> VlistType;
-        typedef std::vector<std::unique_ptr<Edge<T,W>>> ElistType;
+        typedef std::vector<Vertex<T,W>*> VlistType;
+        typedef std::vector<Edge<T,W>*> ElistType;
+
+        /// @return Zwraca komorke macierzy w wierszu r i kolumnie c.
+        const C& cell(const sizeType& r, const sizeType& c) const
+            { return A[r * stride + c]; }
+
+        /// @brief Ustawia obie symetryczne komorki krawedzi.
+        void setCells(const Edge<T,W>* e, const C& value)
+        {
+            const sizeType v = _amg_cvertex_ptr(e->v)->Aindex;
+            const sizeType w = _amg_cvertex_ptr(e->w)->Aindex;
+            A[v * stride + w] = value;
+            A[w * stride + v] = value;
+        }
+
+        /// @return Zwraca zawartosc komorki dla danej krawedzi.
+        static C encode(Edge<T,W>* e)
+        {
+            if constexpr (std::is_same<C, std::uint32_t>::value)
+                return static_cast<std::uint32_t>(e->i + 1);
+            else
+                return e;
+        }
+
+        /// @return Zwraca krawedz zapisana w niepustej komorce.
+        Edge<T,W>* decode(const C& c) const
+        {
+            if constexpr (std::is_same<C, std::uint32_t>::value)
+                return E[c - 1];
+            else
+                return c;
+        }
+
+        /// @brief Zwieksza pojemnosc macierzy, kopiujac zajety blok do nowego bufora.
+        /// @param newStride nowa liczba wierszy i kolumn bufora
+        /// @param n liczba wierszy i kolumn zajetego bloku
+        void grow(const sizeType& newStride, const sizeType& n)
+        {
+            // Pusta macierz wykorzystuje ponownie bufor zachowany po clear()
+            if (n == 0)
+            {
+                A.assign(newStride * newStride, C());
+                stride = newStride;
+                return;
+            }
+            std::vector<C> B(newStride * newStride, C());
+            for (sizeType r = 0; r < n; r++)
+                std::copy(A.begin() + r * stride, A.begin() + r * stride + n, B.begin() + r * newStride);
+            A.swap(B);
+            stride = newStride;
+        }
 
         VlistType V;
         ElistType E;
-        std::vector<std::vector<Edge<T,W>*>> A;
+
+        // Pule przechowujace obiekty wierzcholkow i krawedzi
+        ObjectPool<AdjacencyMatrixVertex<T,W>> Vpool;
+        ObjectPool<AdjacencyMatrixEdge<T,W>> Epool;
+
+        // Macierz sasiedztwa w porzadku wierszowym, poza blokiem V.size() x V.size() wypelniona pustymi komorkami
+        std::vector<C> A;
+        sizeType stride = 0;
 };
 
-#endif
\ No newline at end of file
+/// @brief Graf w reprezentacji macierzy sasiadow z 32-bitowymi komorkami (indeks krawedzi zamiast wskaznika).
+template <typename T, typename W>
+using CompactAdjacencyMatrixGraph = AdjacencyMatrixGraph<T,W,std::uint32_t>;
+
+#endif
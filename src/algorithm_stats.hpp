@@ -0,0 +1,73 @@
+#ifndef ALGORITHM_STATS_HPP
+#define ALGORITHM_STATS_HPP
+
+#include <cstdint>
+
+/// @brief Polityka statystyk, ktora niczego nie zlicza. Wszystkie metody sa puste, wiec kompilator
+/// usuwa ich wywolania i algorytm dziala tak samo szybko jak bez instrumentacji.
+struct NoStats
+{
+    static constexpr bool enabled = false;
+
+    void push() {}
+    void pop() {}
+    void stalePop() {}
+    void decreaseKey() {}
+    void relaxAttempt() {}
+    void relaxSuccess() {}
+    void incidentEdges() {}
+};
+
+/// @brief Polityka statystyk zliczajaca operacje wykonane przez algorytm najkrotszych sciezek.
+struct CountingStats
+{
+    static constexpr bool enabled = true;
+
+    // Dodania do kolejki priorytetowej
+    std::uint64_t pushes = 0;
+
+    // Usuniecia z kolejki, lacznie z przestarzalymi wpisami
+    std::uint64_t pops = 0;
+
+    // Usuniecia wpisow wierzcholkow juz przetworzonych (zawsze 0 dla kolejek z operacja decreaseKey)
+    std::uint64_t stalePops = 0;
+
+    // Zmniejszenia klucza elementu znajdujacego sie w kolejce
+    std::uint64_t decreaseKeys = 0;
+
+    // Sprawdzone krawedzie i krawedzie, ktore skrocily odleglosc
+    std::uint64_t relaxAttempts = 0;
+    std::uint64_t relaxSuccesses = 0;
+
+    // Pobrania listy krawedzi incydentnych
+    std::uint64_t incidentEdgesCalls = 0;
+
+    void push()
+        { ++pushes; }
+    void pop()
+        { ++pops; }
+    void stalePop()
+        { ++stalePops; }
+    void decreaseKey()
+        { ++decreaseKeys; }
+    void relaxAttempt()
+        { ++relaxAttempts; }
+    void relaxSuccess()
+        { ++relaxSuccesses; }
+    void incidentEdges()
+        { ++incidentEdgesCalls; }
+
+    CountingStats& operator+=(const CountingStats& other)
+    {
+        pushes += other.pushes;
+        pops += other.pops;
+        stalePops += other.stalePops;
+        decreaseKeys += other.decreaseKeys;
+        relaxAttempts += other.relaxAttempts;
+        relaxSuccesses += other.relaxSuccesses;
+        incidentEdgesCalls += other.incidentEdgesCalls;
+        return *this;
+    }
+};
+
+#endif
@@ -0,0 +1,503 @@
+#ifndef ALT_HPP
+#define ALT_HPP
+
+#include <vector>
+#include <memory>
+#include <random>
+#include <limits>
+#include <climits>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+
+#include "graph.hpp"
+#include "csr_graph.hpp"
+#include "priority_queue.hpp"
+#include "algorithm_stats.hpp"
+#include "bidirectional_dijkstra.hpp"
+#include "delta_stepping.hpp"
+#include "multi_source.hpp"
+#include "thread_pool.hpp"
+#include "trace.hpp"
+
+/// @brief Heurystyka wyboru punktow orientacyjnych (landmarkow).
+enum class LandmarkSelection
+{
+    // Losowe wierzcholki; wszystkie tablice liczone sa jednoczesnie
+    Random,
+
+    // Kazdy kolejny landmark jest najdalej od juz wybranych
+    Farthest,
+
+    // Heurystyka avoid (Goldberg, Werneck): lisc poddrzewa drzewa najkrotszych sciezek, w ktorym
+    // dotychczasowe ograniczenia dolne sa najslabsze
+    Avoid
+};
+
+/// @brief Algorytm ALT (A*, landmarki, nierownosc trojkata). Przetwarzanie wstepne wybiera landmarki i zapisuje
+/// odleglosci od nich do kazdego wierzcholka. Zapytanie A* uzywa ograniczenia dolnego
+/// d(v, t) >= |d(L, t) - d(L, v)| dla kazdego landmarka L.
+/// Obsluguje tylko wagi int, ktorych odleglosci mieszcza sie w calkowitych komorkach tablicy landmarkow.
+/// @tparam C typ komorki tablicy odleglosci: std::uint32_t (dokladne odleglosci) albo std::uint16_t
+/// (odleglosci kwantowane, ograniczenie dolne s * |q(t) - q(v)| - (s - 1) dla skali s)
+/// @tparam Q kolejka priorytetowa adresowana indeksem wierzcholka (BinaryHeap, QuaternaryHeap, PairingHeap)
+template <typename C = std::uint32_t, template <typename> class Q = BinaryHeap>
+class ALTAlgorithm
+{
+    static_assert(std::is_same<C, std::uint32_t>::value || std::is_same<C, std::uint16_t>::value,
+                  "Komorka tablicy landmarkow musi byc typu std::uint32_t albo std::uint16_t");
+
+    public:
+        /// @brief Konstruktor tworzacy wlasna pule watkow dla przetwarzania wstepnego.
+        /// @param threads liczba watkow (0 - liczba rdzeni)
+        /// @param pin przypiecie watkow do kolejnych rdzeni (tylko Linux)
+        ALTAlgorithm(const sizeType& threads = 0, const bool& pin = false):
+            ownedPool{new ThreadPool(threads, pin)}, pool{ownedPool.get()}, sssp{*pool} {}
+
+        /// @brief Konstruktor korzystajacy z istniejacej puli watkow.
+        /// @param pool pula watkow, ktora musi istniec dluzej niz ten obiekt
+        ALTAlgorithm(ThreadPool& pool): pool{&pool}, sssp{pool} {}
+
+        /// @brief Wybiera landmarki i wyznacza tablice odleglosci. Przy heurystykach Farthest i Avoid kazdy
+        /// landmark zalezy od poprzednich, wiec rownolegle wykonywane jest kazde pojedyncze wyszukiwanie
+        /// (delta-stepping); przy heurystyce Random wszystkie wyszukiwania wykonywane sa jednoczesnie.
+        /// @param graph widok grafu w formacie CSR (CSRGraph, MappedGraph albo CSRView) z nieujemnymi wagami krawedzi
+        /// @param count liczba landmarkow (mniej, jezeli graf ma mniej wierzcholkow)
+        /// @param selection heurystyka wyboru landmarkow
+        /// @param seed ziarno losowania wierzcholkow poczatkowych
+        void preprocess(const CSRView<int>& graph, sizeType count, const LandmarkSelection& selection = LandmarkSelection::Avoid,
+                        const std::uint64_t& seed = 5489u)
+        {
+            TRACE_SPAN("ALTAlgorithm::preprocess");
+            const sizeType n = graph.sizeV();
+            count = std::min(count, n);
+            chosen.clear();
+            table.clear();
+            vertices = n;
+            if (count == 0)
+                return;
+
+            std::mt19937_64 engine(seed);
+            std::vector<int> rows;
+            if (selection == LandmarkSelection::Random)
+            {
+                std::vector<sizeType> order(n);
+                for (sizeType i = 0; i < n; i++)
+                    order[i] = i;
+                for (sizeType i = 0; i < count; i++)
+                    std::swap(order[i], order[std::uniform_int_distribution<sizeType>(i, n - 1)(engine)]);
+                chosen.assign(order.begin(), order.begin() + count);
+                rows.resize(count * n);
+                MultiSourceShortestPaths(*pool).run(graph, chosen, rows.data());
+            }
+            else if (selection == LandmarkSelection::Farthest)
+                selectFarthest(graph, count, engine, rows);
+            else
+                selectAvoid(graph, count, engine, rows);
+
+            store(rows);
+        }
+
+        /// @brief Wybiera landmarki i wyznacza tablice odleglosci. Graf zamieniany jest najpierw na migawke CSR.
+        /// @tparam T typ elementow na wierzcholkach
+        /// @param graph referencja do nieskierowanego grafu prostego z nieujemnymi wagami krawedzi
+        /// @param count liczba landmarkow
+        /// @param selection heurystyka wyboru landmarkow
+        /// @param seed ziarno losowania wierzcholkow poczatkowych
+        template <typename T>
+        void preprocess(const GraphADT<T,int>* graph, const sizeType& count, const LandmarkSelection& selection = LandmarkSelection::Avoid,
+                        const std::uint64_t& seed = 5489u)
+            { preprocess(graph->freeze(), count, selection, seed); }
+
+        /// @return Zwraca indeksy wybranych landmarkow.
+        const std::vector<sizeType>& landmarks() const
+            { return chosen; }
+
+        /// @return Zwraca skale kwantyzacji (1 dla dokladnych odleglosci).
+        int quantisation() const
+            { return scale; }
+
+        /// @return Zwraca rozmiar tablic odleglosci w bajtach.
+        sizeType tableBytes() const
+            { return table.size() * sizeof(C); }
+
+        /// @param v indeks wierzcholka
+        /// @param t indeks wierzcholka docelowego
+        /// @return Zwraca ograniczenie dolne odleglosci d(v, t).
+        std::int64_t lowerBound(const sizeType& v, const sizeType& t) const
+        {
+            const sizeType k = chosen.size();
+            const C* rv = table.data() + v * k;
+            const C* rt = table.data() + t * k;
+            std::int64_t bound = 0;
+            for (sizeType l = 0; l < k; l++)
+            {
+                std::int64_t b;
+                if (rv[l] == INF && rt[l] == INF)
+                    continue;
+                else if (rv[l] == INF || rt[l] == INF)
+                {
+                    // Odleglosc INT_MAX oznacza brak sciezki albo sciezke nie krotsza niz INT_MAX, wiec
+                    // d(v, t) >= INT_MAX - d(L, x) dla wierzcholka x o znanej odleglosci
+                    const std::int64_t known = rv[l] == INF ? rt[l] : rv[l];
+                    b = INT_MAX - (scale * known + scale - 1);
+                }
+                else
+                {
+                    const std::int64_t difference = rv[l] > rt[l] ? rv[l] - rt[l] : rt[l] - rv[l];
+                    b = difference ? scale * difference - (scale - 1) : 0;
+                }
+                if (b > bound)
+                    bound = b;
+            }
+            return bound;
+        }
+
+        /// @brief Zapytanie A* z ograniczeniami dolnymi z landmarkow.
+        /// @tparam T typ elementow na wierzcholkach
+        /// @param graph referencja do grafu, dla ktorego wykonano przetwarzanie wstepne
+        /// @param source referencja do wierzcholka poczatkowego
+        /// @param target referencja do wierzcholka docelowego
+        /// @return Zwraca dlugosc i przebieg najkrotszej sciezki oraz liczbe zdjetych z kolejki wierzcholkow.
+        template <typename T>
+        PointToPointResult shortestPath(const GraphADT<T,int>* graph, const Vertex<T,int>* source, const Vertex<T,int>* target)
+        {
+            NoStats stats;
+            return shortestPath(graph, source, target, stats);
+        }
+
+        /// @brief Zapytanie A* z ograniczeniami dolnymi z landmarkow, zliczajace wykonane operacje.
+        /// @tparam T typ elementow na wierzcholkach
+        /// @tparam S polityka statystyk (NoStats, CountingStats)
+        /// @param graph referencja do grafu, dla ktorego wykonano przetwarzanie wstepne
+        /// @param source referencja do wierzcholka poczatkowego
+        /// @param target referencja do wierzcholka docelowego
+        /// @param stats statystyki, do ktorych dopisywane sa operacje algorytmu
+        /// @return Zwraca dlugosc i przebieg najkrotszej sciezki oraz liczbe zdjetych z kolejki wierzcholkow.
+        template <typename T, typename S>
+        PointToPointResult shortestPath(const GraphADT<T,int>* graph, const Vertex<T,int>* source, const Vertex<T,int>* target, S& stats)
+        {
+            TRACE_SPAN("ALTAlgorithm::shortestPath");
+            auto neighbours = [graph](const sizeType& u, auto&& visit)
+            {
+                const Vertex<T,int>* vu = graph->vertex(u);
+                for (auto e : graph->incidentEdgesRange(vu))
+                    visit(graph->opposite(vu, e)->i, e->element);
+            };
+            return search(graph->sizeV(), source->i, target->i, neighbours, stats);
+        }
+
+        /// @brief Zapytanie A* dla grafu w formacie CSR.
+        /// @param graph graf, dla ktorego wykonano przetwarzanie wstepne
+        /// @param source indeks wierzcholka poczatkowego
+        /// @param target indeks wierzcholka docelowego
+        /// @return Zwraca dlugosc i przebieg najkrotszej sciezki oraz liczbe zdjetych z kolejki wierzcholkow.
+        PointToPointResult shortestPath(const CSRView<int>& graph, const sizeType& source, const sizeType& target)
+        {
+            NoStats stats;
+            return shortestPath(graph, source, target, stats);
+        }
+
+        /// @brief Zapytanie A* dla grafu w formacie CSR, zliczajace wykonane operacje.
+        /// @tparam S polityka statystyk (NoStats, CountingStats)
+        /// @param graph graf, dla ktorego wykonano przetwarzanie wstepne
+        /// @param source indeks wierzcholka poczatkowego
+        /// @param target indeks wierzcholka docelowego
+        /// @param stats statystyki, do ktorych dopisywane sa operacje algorytmu
+        /// @return Zwraca dlugosc i przebieg najkrotszej sciezki oraz liczbe zdjetych z kolejki wierzcholkow.
+        template <typename S>
+        PointToPointResult shortestPath(const CSRView<int>& graph, const sizeType& source, const sizeType& target, S& stats)
+        {
+            TRACE_SPAN("ALTAlgorithm::shortestPath(CSR)");
+            auto neighbours = [&graph](const sizeType& u, auto&& visit)
+            {
+                for (sizeType k = graph.offset(u); k < graph.offset(u + 1); k++)
+                    visit(graph.target(k), graph.weight(k));
+            };
+            return search(graph.sizeV(), source, target, neighbours, stats);
+        }
+
+    private:
+        static constexpr C INF = std::numeric_limits<C>::max();
+        static constexpr std::uint32_t NONE = UINT32_MAX;
+        static constexpr std::int64_t UNKNOWN = -1;
+
+        /// @brief Heurystyka Farthest: pierwszy landmark jest najdalej od losowego wierzcholka, kazdy kolejny
+        /// maksymalizuje odleglosc do najblizszego z juz wybranych (wierzcholki nieosiagalne maja pierwszenstwo).
+        void selectFarthest(const CSRView<int>& graph, const sizeType& count, std::mt19937_64& engine, std::vector<int>& rows)
+        {
+            const sizeType n = graph.sizeV();
+            const sizeType root = std::uniform_int_distribution<sizeType>(0, n - 1)(engine);
+            std::vector<int> nearest = sssp.shortestPath(graph, root);
+            nearest[root] = 0;
+
+            while (chosen.size() < count)
+            {
+                const sizeType next = std::max_element(nearest.begin(), nearest.end()) - nearest.begin();
+                if (nearest[next] == 0)
+                    break;
+                chosen.push_back(next);
+
+                std::vector<int> D = sssp.shortestPath(graph, next);
+                rows.insert(rows.end(), D.begin(), D.end());
+                if (chosen.size() == 1)
+                    nearest = D;
+                else
+                    for (sizeType v = 0; v < n; v++)
+                        nearest[v] = std::min(nearest[v], D[v]);
+                for (auto & l : chosen)
+                    nearest[l] = 0;
+            }
+        }
+
+        /// @brief Heurystyka Avoid. Dla drzewa najkrotszych sciezek z losowego korzenia r waga wierzcholka to
+        /// d(r, v) - ograniczenie dolne d(r, v), a rozmiar to suma wag poddrzewa (0, jezeli poddrzewo zawiera
+        /// landmark). Od wierzcholka o najwiekszym rozmiarze schodzi sie do dziecka o najwiekszym rozmiarze
+        /// az do liscia, ktory zostaje landmarkiem.
+        void selectAvoid(const CSRView<int>& graph, const sizeType& count, std::mt19937_64& engine, std::vector<int>& rows)
+        {
+            const sizeType n = graph.sizeV();
+            std::vector<std::uint32_t> parent(n);
+            std::vector<std::int64_t> size(n);
+            std::vector<char> covered(n);
+            std::vector<sizeType> order;
+            std::vector<sizeType> childOffsets(n + 1);
+            std::vector<std::uint32_t> children;
+            std::vector<char> isLandmark(n, 0);
+
+            while (chosen.size() < count)
+            {
+                const sizeType root = std::uniform_int_distribution<sizeType>(0, n - 1)(engine);
+                const std::vector<int> D = sssp.shortestPath(graph, root);
+
+                // Rodzic w drzewie najkrotszych sciezek odtwarzany z odleglosci (scisle mniejsza odleglosc wyklucza cykle)
+                pool->parallelFor(n, [&](sizeType, sizeType v)
+                {
+                    parent[v] = NONE;
+                    if (D[v] == INT_MAX)
+                        return;
+                    for (sizeType k = graph.offset(v); k < graph.offset(v + 1); k++)
+                    {
+                        const sizeType u = graph.target(k);
+                        if (D[u] < D[v] && static_cast<std::int64_t>(D[u]) + graph.weight(k) == D[v])
+                        {
+                            parent[v] = static_cast<std::uint32_t>(u);
+                            break;
+                        }
+                    }
+                });
+
+                // Rozmiary poddrzew liczone od lisci, czyli w kolejnosci malejacych odleglosci
+                order.clear();
+                for (sizeType v = 0; v < n; v++)
+                    if (D[v] != INT_MAX)
+                        order.push_back(v);
+                std::sort(order.begin(), order.end(), [&D](const sizeType& a, const sizeType& b) { return D[a] > D[b]; });
+
+                std::vector<int> bounds(n, 0);
+                for (sizeType l = 0; l < chosen.size(); l++)
+                {
+                    const int* row = rows.data() + l * n;
+                    if (row[root] == INT_MAX)
+                        continue;
+                    for (auto & v : order)
+                        if (row[v] != INT_MAX)
+                            bounds[v] = std::max(bounds[v], std::abs(row[root] - row[v]));
+                }
+
+                for (auto & v : order)
+                {
+                    size[v] = static_cast<std::int64_t>(D[v]) - bounds[v];
+                    covered[v] = isLandmark[v];
+                }
+                for (auto & v : order)
+                    if (parent[v] != NONE)
+                    {
+                        size[parent[v]] += size[v];
+                        covered[parent[v]] |= covered[v];
+                    }
+
+                std::fill(childOffsets.begin(), childOffsets.end(), 0);
+                for (auto & v : order)
+                    if (parent[v] != NONE)
+                        ++childOffsets[parent[v] + 1];
+                for (sizeType v = 0; v < n; v++)
+                    childOffsets[v + 1] += childOffsets[v];
+                children.assign(childOffsets[n], 0);
+                {
+                    std::vector<sizeType> fill(childOffsets.begin(), childOffsets.end() - 1);
+                    for (auto & v : order)
+                        if (parent[v] != NONE)
+                            children[fill[parent[v]]++] = static_cast<std::uint32_t>(v);
+                }
+
+                sizeType best = n;
+                for (auto & v : order)
+                    if (!covered[v] && (best == n || size[v] > size[best]))
+                        best = v;
+
+                if (best == n)
+                {
+                    // Wszystkie poddrzewa zawieraja landmark - wybor dowolnego wierzcholka spoza landmarkow
+                    for (sizeType v = 0; v < n && best == n; v++)
+                        if (!isLandmark[v])
+                            best = v;
+                    if (best == n)
+                        break;
+                }
+                else
+                    while (true)
+                    {
+                        sizeType next = n;
+                        for (sizeType c = childOffsets[best]; c < childOffsets[best + 1]; c++)
+                        {
+                            const sizeType child = children[c];
+                            if (!covered[child] && (next == n || size[child] > size[next]))
+                                next = child;
+                        }
+                        if (next == n)
+                            break;
+                        best = next;
+                    }
+
+                chosen.push_back(best);
+                isLandmark[best] = 1;
+                std::vector<int> row = sssp.shortestPath(graph, best);
+                rows.insert(rows.end(), row.begin(), row.end());
+            }
+        }
+
+        /// @brief Zapisuje odleglosci landmark x wierzcholek jako tablice wierzcholek x landmark typu C, tak aby
+        /// ograniczenie dla jednego wierzcholka odczytywalo ciagly fragment pamieci.
+        void store(const std::vector<int>& rows)
+        {
+            const sizeType n = vertices;
+            const sizeType k = chosen.size();
+
+            int farthest = 0;
+            for (auto & d : rows)
+                if (d != INT_MAX && d > farthest)
+                    farthest = d;
+            // Najwieksza kwantowana wartosc musi byc mniejsza od znacznika INF
+            scale = static_cast<int>(farthest / static_cast<std::int64_t>(INF) + 1);
+
+            table.assign(n * k, INF);
+            pool->parallelFor(k, [&](sizeType, sizeType l)
+            {
+                const int* row = rows.data() + l * n;
+                for (sizeType v = 0; v < n; v++)
+                    if (row[v] != INT_MAX)
+                        table[v * k + l] = static_cast<C>(row[v] / scale);
+            });
+        }
+
+        template <typename N, typename S>
+        PointToPointResult search(const sizeType& n, const sizeType& source, const sizeType& target, const N& neighbours, S& stats)
+        {
+            if (D.size() != n)
+            {
+                D.assign(n, INT_MAX);
+                H.assign(n, UNKNOWN);
+                parent.assign(n, NONE);
+                touched.clear();
+                queue.resize(n);
+            }
+
+            PointToPointResult result;
+            if (source == target)
+            {
+                result.distance = 0;
+                result.path.push_back(source);
+                return result;
+            }
+
+            H[source] = potential(source, target);
+            touched.push_back(static_cast<std::uint32_t>(source));
+            D[source] = 0;
+            queue.push(source, H[source]);
+            stats.push();
+
+            // Ograniczenie kwantowane nie musi byc spojne, wiec wierzcholek moze wrocic do kolejki po poprawie odleglosci;
+            // przy dopuszczalnym ograniczeniu pierwsze zdjecie celu z kolejki daje najkrotsza sciezke
+            while (!queue.empty())
+            {
+                const sizeType u = queue.top();
+                queue.pop();
+                ++result.settled;
+                stats.pop();
+                if (u == target)
+                    break;
+
+                stats.incidentEdges();
+                const int du = D[u];
+                neighbours(u, [&](const sizeType& z, const int& w)
+                {
+                    stats.relaxAttempt();
+                    if (w < D[z] - du)
+                    {
+                        if (H[z] == UNKNOWN)
+                        {
+                            H[z] = potential(z, target);
+                            touched.push_back(static_cast<std::uint32_t>(z));
+                        }
+                        D[z] = du + w;
+                        parent[z] = static_cast<std::uint32_t>(u);
+                        stats.relaxSuccess();
+                        if constexpr (S::enabled)
+                        {
+                            if (queue.contains(z))
+                                stats.decreaseKey();
+                            else
+                                stats.push();
+                        }
+                        queue.pushOrDecrease(z, D[z] + H[z]);
+                    }
+                });
+            }
+
+            if (D[target] != INT_MAX)
+            {
+                result.distance = D[target];
+                for (sizeType x = target; x != NONE; x = parent[x])
+                    result.path.push_back(x);
+                std::reverse(result.path.begin(), result.path.end());
+            }
+
+            for (auto & i : touched)
+            {
+                D[i] = INT_MAX;
+                H[i] = UNKNOWN;
+                parent[i] = NONE;
+            }
+            touched.clear();
+            queue.clear();
+            return result;
+        }
+
+        /// @return Zwraca ograniczenie dolne albo 0, jezeli przetwarzanie wstepne nie dotyczylo tego grafu.
+        std::int64_t potential(const sizeType& v, const sizeType& t) const
+            { return vertices == D.size() ? lowerBound(v, t) : 0; }
+
+        std::unique_ptr<ThreadPool> ownedPool;
+        ThreadPool* pool;
+        DeltaSteppingAlgorithm sssp;
+
+        // Landmarki i tablica odleglosci wierzcholek x landmark
+        std::vector<sizeType> chosen;
+        std::vector<C> table;
+        sizeType vertices = 0;
+        int scale = 1;
+
+        // Przestrzen robocza zapytania, przywracana po kazdym zapytaniu
+        std::vector<int> D;
+        std::vector<std::int64_t> H;
+        std::vector<std::uint32_t> parent;
+        std::vector<std::uint32_t> touched;
+        Q<std::int64_t> queue;
+};
+
+/// @brief Algorytm ALT z tablicami kwantowanymi do 16 bitow na komorke.
+template <template <typename> class Q = BinaryHeap>
+using QuantisedALTAlgorithm = ALTAlgorithm<std::uint16_t, Q>;
+
+#endif
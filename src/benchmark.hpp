@@ -0,0 +1,892 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+#include <thread>
+#include <memory>
+#include <functional>
+#include <array>
+#include <random>
+#include <climits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#include "graph.hpp"
+#include "graph_generator.hpp"
+#include "thread_pool.hpp"
+#include "perf_counters.hpp"
+#include "algorithm_stats.hpp"
+#include "dense_dijkstra.hpp"
+#include "bidirectional_dijkstra.hpp"
+#include "alt.hpp"
+#include "contraction_hierarchy.hpp"
+#include "dynamic_shortest_paths.hpp"
+#include "adjacency_list_graph.hpp"
+#include "graph_loader.hpp"
+
+/// @brief Statystyki zbioru pomiarow czasu (w milisekundach).
+struct BenchmarkStatistics
+{
+    sizeType samples = 0;
+    double min = 0;
+    double median = 0;
+    double p95 = 0;
+    double p99 = 0;
+    double mean = 0;
+    double stddev = 0;
+
+    /// @brief Wylicza statystyki pomiarow. Percentyle interpolowane sa liniowo miedzy sasiednimi pozycjami.
+    /// @param values pomiary
+    /// @return Zwraca statystyki pomiarow.
+    static BenchmarkStatistics compute(std::vector<double> values)
+    {
+        BenchmarkStatistics s;
+        s.samples = values.size();
+        if (values.empty())
+            return s;
+
+        std::sort(values.begin(), values.end());
+        s.min = values.front();
+        s.median = percentile(values, 0.5);
+        s.p95 = percentile(values, 0.95);
+        s.p99 = percentile(values, 0.99);
+
+        double sum = 0;
+        for (auto & i : values)
+            sum += i;
+        s.mean = sum / values.size();
+
+        double squares = 0;
+        for (auto & i : values)
+            squares += (i - s.mean) * (i - s.mean);
+        s.stddev = values.size() > 1 ? std::sqrt(squares / (values.size() - 1)) : 0;
+        return s;
+    }
+
+    private:
+        static double percentile(const std::vector<double>& sorted, const double& q)
+        {
+            const double position = q * (sorted.size() - 1);
+            const sizeType lower = static_cast<sizeType>(position);
+            const sizeType upper = lower + 1 < sorted.size() ? lower + 1 : lower;
+            return sorted[lower] + (position - lower) * (sorted[upper] - sorted[lower]);
+        }
+};
+
+/// @brief Klasa abstrakcyjna mierzonego zapytania.
+class BenchmarkQuery
+{
+    public:
+        virtual ~BenchmarkQuery() = default;
+
+        /// @return Zwraca nazwe zapytania uzywana w raportach.
+        virtual std::string name() const = 0;
+
+        /// @brief Przygotowanie wykonywane raz dla kazdego zbudowanego grafu, poza pomiarem czasu.
+        /// @param graph referencja do grafu
+        virtual void prepare(const GraphADT<int,int>* /*graph*/) {}
+
+        /// @brief Wykonuje mierzone zapytanie.
+        /// @param graph referencja do grafu
+        /// @param source wierzcholek poczatkowy
+        /// @param target wierzcholek docelowy (dla zapytan typu punkt-punkt)
+        virtual void run(const GraphADT<int,int>* graph, const Vertex<int,int>* source, const Vertex<int,int>* target) = 0;
+
+        /// @brief Wykonuje zapytanie poza pomiarem czasu, zliczajac operacje algorytmu.
+        /// @param graph referencja do grafu
+        /// @param source wierzcholek poczatkowy
+        /// @param target wierzcholek docelowy (dla zapytan typu punkt-punkt)
+        /// @param stats statystyki, do ktorych dopisywane sa operacje algorytmu
+        /// @return Zwraca falsz, jezeli zapytanie nie obsluguje zliczania operacji.
+        virtual bool profile(const GraphADT<int,int>* /*graph*/, const Vertex<int,int>* /*source*/, const Vertex<int,int>* /*target*/, CountingStats& /*stats*/)
+            { return false; }
+};
+
+/// @brief Zapytanie wyznaczajace odleglosci od jednego wierzcholka do wszystkich pozostalych.
+/// @tparam D typ odleglosci zwracanych przez algorytm
+template <typename D>
+class BasicSingleSourceQuery : public BenchmarkQuery
+{
+    public:
+        typedef std::vector<D> (*Algorithm)(const GraphADT<int,int>*, const Vertex<int,int>*);
+        typedef std::vector<D> (*CountingAlgorithm)(const GraphADT<int,int>*, const Vertex<int,int>*, CountingStats&);
+
+        /// @brief Podstawowy konstruktor zapytania.
+        /// @param name nazwa zapytania
+        /// @param algorithm mierzony wariant algorytmu
+        /// @param counting wariant algorytmu zliczajacy operacje albo nullptr
+        BasicSingleSourceQuery(const std::string& name, Algorithm algorithm, CountingAlgorithm counting = nullptr):
+            queryName{name}, algorithm{algorithm}, counting{counting} {}
+
+        std::string name() const
+            { return queryName; }
+
+        void run(const GraphADT<int,int>* graph, const Vertex<int,int>* source, const Vertex<int,int>* target)
+        {
+            // Wynik trafia do sumy kontrolnej, aby kompilator nie usunal wywolania
+            std::vector<D> distances = algorithm(graph, source);
+            checksum += distances.empty() ? 0 : static_cast<long long>(distances[target->i]);
+        }
+
+        bool profile(const GraphADT<int,int>* graph, const Vertex<int,int>* source, const Vertex<int,int>* /*target*/, CountingStats& stats)
+        {
+            if (!counting)
+                return false;
+            counting(graph, source, stats);
+            return true;
+        }
+
+        /// @return Zwraca sume kontrolna wynikow.
+        long long getChecksum() const
+            { return checksum; }
+
+    private:
+        std::string queryName;
+        Algorithm algorithm;
+        CountingAlgorithm counting;
+        long long checksum = 0;
+};
+
+typedef BasicSingleSourceQuery<int> SingleSourceQuery;
+
+/// @brief Zapytanie o najkrotsza sciezke miedzy dwoma wierzcholkami, wykonywane dwukierunkowym algorytmem Dijkstry.
+class PointToPointQuery : public BenchmarkQuery
+{
+    public:
+        /// @brief Podstawowy konstruktor zapytania.
+        /// @param name nazwa zapytania
+        PointToPointQuery(const std::string& name = "BidirectionalDijkstra"): queryName{name} {}
+
+        std::string name() const
+            { return queryName; }
+
+        void run(const GraphADT<int,int>* graph, const Vertex<int,int>* source, const Vertex<int,int>* target)
+        {
+            PointToPointResult result = algorithm.shortestPath(graph, source, target);
+            checksum += result.distance + static_cast<long long>(result.path.size());
+        }
+
+        bool profile(const GraphADT<int,int>* graph, const Vertex<int,int>* source, const Vertex<int,int>* target, CountingStats& stats)
+        {
+            algorithm.shortestPath(graph, source, target, stats);
+            return true;
+        }
+
+        /// @return Zwraca sume kontrolna wynikow.
+        long long getChecksum() const
+            { return checksum; }
+
+    private:
+        std::string queryName;
+        BidirectionalDijkstraAlgorithm<BinaryHeap> algorithm;
+        long long checksum = 0;
+};
+
+/// @brief Zapytanie punkt-punkt wykonywane algorytmem ALT. Przetwarzanie wstepne (wybor landmarkow i tablice
+/// odleglosci) wykonywane jest w prepare(), poza pomiarem czasu.
+class LandmarkQuery : public BenchmarkQuery
+{
+    public:
+        /// @brief Podstawowy konstruktor zapytania.
+        /// @param name nazwa zapytania
+        /// @param landmarks liczba landmarkow
+        /// @param selection heurystyka wyboru landmarkow
+        LandmarkQuery(const std::string& name = "ALT", const sizeType& landmarks = 8, const LandmarkSelection& selection = LandmarkSelection::Avoid):
+            queryName{name}, landmarks{landmarks}, selection{selection}, algorithm(1) {}
+
+        std::string name() const
+            { return queryName; }
+
+        void prepare(const GraphADT<int,int>* graph)
+            { algorithm.preprocess(graph, landmarks, selection); }
+
+        void run(const GraphADT<int,int>* graph, const Vertex<int,int>* source, const Vertex<int,int>* target)
+        {
+            PointToPointResult result = algorithm.shortestPath(graph, source, target);
+            checksum += result.distance + static_cast<long long>(result.path.size());
+        }
+
+        bool profile(const GraphADT<int,int>* graph, const Vertex<int,int>* source, const Vertex<int,int>* target, CountingStats& stats)
+        {
+            algorithm.shortestPath(graph, source, target, stats);
+            return true;
+        }
+
+        /// @return Zwraca sume kontrolna wynikow.
+        long long getChecksum() const
+            { return checksum; }
+
+    private:
+        std::string queryName;
+        sizeType landmarks;
+        LandmarkSelection selection;
+        ALTAlgorithm<> algorithm;
+        long long checksum = 0;
+};
+
+/// @brief Zapytanie punkt-punkt wykonywane w hierarchii skrotow. Hierarchia budowana jest w prepare(), poza pomiarem czasu.
+class HierarchyQuery : public BenchmarkQuery
+{
+    public:
+        /// @brief Podstawowy konstruktor zapytania.
+        /// @param name nazwa zapytania
+        /// @param coreDegree sredni stopien, po przekroczeniu ktorego kontrakcja jest przerywana (0 - bez rdzenia)
+        HierarchyQuery(const std::string& name = "ContractionHierarchy", const double& coreDegree = 32):
+            queryName{name}, coreDegree{coreDegree} {}
+
+        std::string name() const
+            { return queryName; }
+
+        void prepare(const GraphADT<int,int>* graph)
+            { hierarchy.build(graph, coreDegree); }
+
+        void run(const GraphADT<int,int>* graph, const Vertex<int,int>* source, const Vertex<int,int>* target)
+        {
+            PointToPointResult result = hierarchy.shortestPath(graph, source, target);
+            checksum += result.distance + static_cast<long long>(result.path.size());
+        }
+
+        bool profile(const GraphADT<int,int>* graph, const Vertex<int,int>* source, const Vertex<int,int>* target, CountingStats& stats)
+        {
+            hierarchy.shortestPath(graph, source, target, stats);
+            return true;
+        }
+
+        /// @return Zwraca sume kontrolna wynikow.
+        long long getChecksum() const
+            { return checksum; }
+
+    private:
+        std::string queryName;
+        double coreDegree;
+        ContractionHierarchy<> hierarchy;
+        long long checksum = 0;
+};
+
+/// @brief Zapytanie mierzace aktualizacje odleglosci od stalego zrodla (wierzcholek 0) po zmianie wagi jednej krawedzi.
+/// Dziala na wlasnej kopii grafu (lista sasiedztwa) tworzonej w prepare(). Kazde wykonanie mnozy wage losowej
+/// krawedzi przez losowy czynnik z przedzialu [1/2, 2], po czym naprawia odleglosci przyrostowo (DynamicShortestPaths)
+/// albo wyznacza je od nowa algorytmem Dijkstry. Oba warianty wykonuja te same zmiany na tych samych grafach.
+class EdgeUpdateQuery : public BenchmarkQuery
+{
+    public:
+        /// @brief Podstawowy konstruktor zapytania.
+        /// @param name nazwa zapytania
+        /// @param repair naprawa przyrostowa (true) albo pelne przeliczenie (false)
+        EdgeUpdateQuery(const std::string& name, const bool& repair): queryName{name}, repair{repair} {}
+
+        std::string name() const
+            { return queryName; }
+
+        void prepare(const GraphADT<int,int>* graph)
+        {
+            dynamic.reset();
+            copy.clear();
+            for (sizeType i = 0; i < graph->sizeV(); i++)
+                copy.insertVertex(graph->vertex(i)->element);
+            for (sizeType i = 0; i < graph->sizeE(); i++)
+            {
+                const Edge<int,int>* e = graph->edge(i);
+                copy.insertEdge(copy.vertex(e->v->i), copy.vertex(e->w->i), e->element);
+            }
+
+            engine.seed(5489u);
+            if (repair)
+                dynamic.reset(new DynamicShortestPaths<int>(&copy, copy.vertex(0)));
+            else
+            {
+                D.resize(copy.sizeV());
+                P.resize(copy.sizeV());
+                queue.resize(copy.sizeV());
+                recompute();
+            }
+        }
+
+        void run(const GraphADT<int,int>* /*graph*/, const Vertex<int,int>* /*source*/, const Vertex<int,int>* target)
+        {
+            if (copy.sizeE() == 0)
+                return;
+            Edge<int,int>* e = copy.edge(std::uniform_int_distribution<sizeType>(0, copy.sizeE() - 1)(engine));
+            const std::int64_t scaled = static_cast<std::int64_t>(e->element) * std::uniform_int_distribution<int>(50, 200)(engine) / 100;
+            const int weight = static_cast<int>(std::min<std::int64_t>(scaled, INT_MAX - 1));
+
+            copy.replace(e, weight);
+            if (!repair)
+                recompute();
+            checksum += repair ? dynamic->distance(target->i) : D[target->i];
+        }
+
+        /// @return Zwraca sume kontrolna wynikow.
+        long long getChecksum() const
+            { return checksum; }
+
+    private:
+        void recompute()
+        {
+            NoStats stats;
+            DijkstraAlgorithm::shortestPath<true>(&copy, copy.vertex(0), D.data(), P.data(), queue, stats);
+        }
+
+        std::string queryName;
+        bool repair;
+        AdjacencyListGraph<int,int> copy;
+        std::unique_ptr<DynamicShortestPaths<int>> dynamic;
+        std::vector<int> D;
+        std::vector<std::uint32_t> P;
+        BinaryHeap<int> queue;
+        std::mt19937_64 engine;
+        long long checksum = 0;
+};
+
+/// @brief Parametry pomiarow.
+struct BenchmarkConfig
+{
+    // Liczby wierzcholkow i gestosci tworzace siatke pomiarow
+    std::vector<int> verticesNumbers;
+    std::vector<double> densities;
+
+    // Liczba poczatkowych grafow w komorce, ktorych wyniki sa odrzucane
+    sizeType warmup = 2;
+
+    // Liczba grafow mierzonych w komorce
+    sizeType repetitions = 100;
+
+    // Liczba zapytan na kazdym zbudowanym grafie
+    sizeType queriesPerGraph = 1;
+
+    // Ziarno generatora grafow i wierzcholkow zapytan
+    std::uint64_t seed = 5489u;
+
+    // Wypisywanie podsumowania kazdej komorki na std::cout
+    bool verbose = true;
+
+    // Liczba watkow wykonujacych proby w trybie rownoleglym (0 - liczba rdzeni)
+    sizeType threads = 1;
+
+    // Przypiecie watkow do kolejnych rdzeni (tylko Linux)
+    bool pinThreads = false;
+
+    // Odczyt licznikow sprzetowych wokol kazdego mierzonego fragmentu (tylko Linux, wymaga dostepu do perf_event_open)
+    bool counters = false;
+
+    // Dodatkowe, niemierzone wykonanie kazdego zapytania ze zliczaniem operacji algorytmu
+    bool workStats = false;
+
+    // Plik z grafem rzeczywistym (DIMACS .gr albo lista krawedzi SNAP). Jezeli jest ustawiony, siatka losowych
+    // grafow zastepowana jest jedna komorka, a kazda proba buduje graf z wczytanej raz migawki.
+    std::string inputPath;
+};
+
+/// @brief Wynik pomiarow jednej komorki (reprezentacja, zapytanie, liczba wierzcholkow, gestosc).
+struct BenchmarkResult
+{
+    std::string graph;
+    std::string query;
+    int vertices;
+    double density;
+    sizeType edges;
+    BenchmarkStatistics buildTime;
+    BenchmarkStatistics queryTime;
+
+    // Mediany licznikow sprzetowych (NaN, jezeli liczniki byly wylaczone lub niedostepne)
+    PerfSample buildCounters;
+    PerfSample queryCounters;
+
+    // Suma operacji algorytmu i liczba zapytan, dla ktorych je zliczono
+    CountingStats work;
+    sizeType workQueries = 0;
+};
+
+/// @brief Podstawowe informacje o maszynie i kompilacji, zapisywane razem z wynikami.
+struct MachineInfo
+{
+    std::string hostname;
+    std::string cpu;
+    unsigned threads;
+    std::string compiler;
+    long standard;
+    bool optimized;
+    std::string simd;
+    std::string timestamp;
+
+    /// @return Zwraca informacje o biezacej maszynie.
+    static MachineInfo current()
+    {
+        MachineInfo info;
+        info.hostname = "unknown";
+#if defined(__unix__) || defined(__APPLE__)
+        char name[256] = {};
+        if (gethostname(name, sizeof(name) - 1) == 0)
+            info.hostname = name;
+#endif
+        info.cpu = "unknown";
+        std::ifstream cpuinfo("/proc/cpuinfo");
+        std::string line;
+        while (std::getline(cpuinfo, line))
+            if (line.compare(0, 10, "model name") == 0)
+            {
+                std::size_t colon = line.find(':');
+                if (colon != std::string::npos)
+                    info.cpu = line.substr(line.find_first_not_of(' ', colon + 1));
+                break;
+            }
+        info.threads = std::thread::hardware_concurrency();
+#if defined(__clang__)
+        info.compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+        info.compiler = "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+        info.compiler = "msvc " + std::to_string(_MSC_VER);
+#else
+        info.compiler = "unknown";
+#endif
+        info.standard = __cplusplus;
+#ifdef NDEBUG
+        info.optimized = true;
+#else
+        info.optimized = false;
+#endif
+        info.simd = DenseDijkstraAlgorithm::simdPath();
+        char buffer[32] = {};
+        std::time_t now = std::time(nullptr);
+        std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+        info.timestamp = buffer;
+        return info;
+    }
+};
+
+/// @brief Podsystem pomiarow czasu dzialania zapytan na losowych grafach. Budowa grafu mierzona jest
+/// osobno od zapytan, a wyniki raportowane sa jako statystyki (min, mediana, p95, p99, srednia, odchylenie).
+class Benchmark
+{
+    public:
+        /// @brief Podstawowy konstruktor.
+        /// @param config parametry pomiarow
+        Benchmark(const BenchmarkConfig& config): config{config}, machine{MachineInfo::current()} {}
+
+        typedef std::function<std::unique_ptr<GraphADT<int,int>>()> GraphFactory;
+        typedef std::function<std::unique_ptr<BenchmarkQuery>()> QueryFactory;
+
+        /// @brief Wykonuje pomiary dla wszystkich komorek siatki na jednym watku i dopisuje wyniki.
+        /// @param graphName nazwa reprezentacji grafu uzywana w raportach
+        /// @param graph referencja do grafu, ktory jest wielokrotnie czyszczony i budowany od nowa
+        /// @param query mierzone zapytanie
+        void run(const std::string& graphName, GraphADT<int,int>* graph, BenchmarkQuery& query)
+        {
+            std::vector<Worker> workers{ Worker{ graph, &query } };
+            runCells(graphName, workers);
+        }
+
+        /// @brief Wykonuje pomiary dla wszystkich komorek siatki na config.threads watkach i dopisuje wyniki.
+        /// Kazdy watek otrzymuje wlasny graf i wlasna instancje zapytania, a proby komorki rozdzielane sa
+        /// miedzy watki. Kazda proba ma wlasne ziarno, wiec wyniki nie zaleza od przydzialu prob do watkow.
+        /// @param graphName nazwa reprezentacji grafu uzywana w raportach
+        /// @param makeGraph funkcja tworzaca pusty graf
+        /// @param makeQuery funkcja tworzaca mierzone zapytanie
+        void run(const std::string& graphName, const GraphFactory& makeGraph, const QueryFactory& makeQuery)
+        {
+            if (!pool)
+                pool.reset(new ThreadPool(config.threads, config.pinThreads));
+
+            std::vector<std::unique_ptr<GraphADT<int,int>>> graphs;
+            std::vector<std::unique_ptr<BenchmarkQuery>> queries;
+            std::vector<Worker> workers;
+            for (sizeType i = 0; i < pool->size(); i++)
+            {
+                graphs.push_back(makeGraph());
+                queries.push_back(makeQuery());
+                workers.push_back(Worker{ graphs.back().get(), queries.back().get() });
+            }
+            runCells(graphName, workers);
+        }
+
+        /// @return Zwraca zebrane wyniki.
+        const std::vector<BenchmarkResult>& results() const
+            { return resultsList; }
+
+        /// @brief Zapisuje wyniki do pliku z rozszerzeniem csv, jeden wiersz na komorke.
+        /// @param filePath sciezka do pliku .csv
+        /// @param separator separator uzywany w pliku z rozszerzeniem csv
+        void saveToCSV(const std::string& filePath, const char& separator = ';') const
+        {
+            std::ofstream output(filePath);
+            const char s = separator;
+
+            output << "graph" << s << "query" << s << "vertices" << s << "density" << s << "edges";
+            for (const char* prefix : { "build", "query" })
+                output << s << prefix << "_samples" << s << prefix << "_min" << s << prefix << "_median"
+                       << s << prefix << "_p95" << s << prefix << "_p99" << s << prefix << "_mean" << s << prefix << "_stddev";
+            if (config.counters)
+                for (const char* prefix : { "build", "query" })
+                    for (sizeType e = 0; e < PerfSample::EVENTS; e++)
+                        output << s << prefix << '_' << PerfSample::name(e);
+            if (config.workStats)
+                for (const char* name : WORK_NAMES)
+                    output << s << name;
+            output << '\n';
+
+            for (auto & r : resultsList)
+            {
+                output << r.graph << s << r.query << s << r.vertices << s << r.density << s << r.edges;
+                for (const BenchmarkStatistics* st : { &r.buildTime, &r.queryTime })
+                    output << s << st->samples << s << st->min << s << st->median << s << st->p95
+                           << s << st->p99 << s << st->mean << s << st->stddev;
+                if (config.counters)
+                    for (const PerfSample* c : { &r.buildCounters, &r.queryCounters })
+                        for (auto & v : c->values)
+                        {
+                            // Niedostepny licznik zapisywany jest jako puste pole
+                            output << s;
+                            if (v == v)
+                                output << v;
+                        }
+                if (config.workStats)
+                    for (auto & v : workPerQuery(r))
+                    {
+                        output << s;
+                        if (r.workQueries)
+                            output << v;
+                    }
+                output << '\n';
+            }
+            output << std::flush;
+        }
+
+        /// @brief Zapisuje wyniki wraz z informacjami o maszynie i parametrach pomiarow do pliku JSON.
+        /// @param filePath sciezka do pliku .json
+        void saveToJSON(const std::string& filePath) const
+        {
+            std::ofstream output(filePath);
+            output << "{\n  \"machine\": {"
+                   << "\"hostname\": " << quote(machine.hostname)
+                   << ", \"cpu\": " << quote(machine.cpu)
+                   << ", \"threads\": " << machine.threads
+                   << ", \"compiler\": " << quote(machine.compiler)
+                   << ", \"cplusplus\": " << machine.standard
+                   << ", \"optimized\": " << (machine.optimized ? "true" : "false")
+                   << ", \"simd\": " << quote(machine.simd)
+                   << ", \"timestamp\": " << quote(machine.timestamp) << "},\n";
+            output << "  \"config\": {"
+                   << "\"warmup\": " << config.warmup
+                   << ", \"repetitions\": " << config.repetitions
+                   << ", \"queriesPerGraph\": " << config.queriesPerGraph
+                   << ", \"seed\": " << config.seed
+                   << ", \"threads\": " << (pool ? pool->size() : 1)
+                   << ", \"pinThreads\": " << (config.pinThreads ? "true" : "false")
+                   << ", \"counters\": " << (config.counters ? "true" : "false")
+                   << ", \"workStats\": " << (config.workStats ? "true" : "false") << "},\n";
+            output << "  \"results\": [";
+            for (sizeType i = 0; i < resultsList.size(); i++)
+            {
+                const BenchmarkResult& r = resultsList[i];
+                output << (i ? ",\n    " : "\n    ")
+                       << "{\"graph\": " << quote(r.graph) << ", \"query\": " << quote(r.query)
+                       << ", \"vertices\": " << r.vertices << ", \"density\": " << r.density << ", \"edges\": " << r.edges
+                       << ", \"buildTime\": " << statistics(r.buildTime) << ", \"queryTime\": " << statistics(r.queryTime);
+                if (config.counters)
+                    output << ", \"buildCounters\": " << counterValues(r.buildCounters) << ", \"queryCounters\": " << counterValues(r.queryCounters);
+                if (config.workStats)
+                    output << ", \"work\": " << workValues(r);
+                output << "}";
+            }
+            output << "\n  ]\n}\n" << std::flush;
+        }
+
+    private:
+        /// @brief Graf i zapytanie nalezace do jednego watku.
+        struct Worker
+        {
+            GraphADT<int,int>* graph;
+            BenchmarkQuery* query;
+        };
+
+        /// @brief Pomiary jednej proby: budowa grafu i zapytania na nim.
+        struct Trial
+        {
+            double build = 0;
+            sizeType edges = 0;
+            std::vector<double> queries;
+            PerfSample buildCounters;
+            std::vector<PerfSample> queryCounters;
+            CountingStats work;
+            sizeType workQueries = 0;
+        };
+
+        void runCells(const std::string& graphName, std::vector<Worker>& workers)
+        {
+            std::vector<int> verticesNumbers = config.verticesNumbers;
+            std::vector<double> densities = config.densities;
+            if (!config.inputPath.empty())
+            {
+                if (!loadInput())
+                {
+                    std::cerr << "Nie mozna wczytac grafu z pliku " << config.inputPath << std::endl;
+                    return;
+                }
+                const double n = input->sizeV();
+                verticesNumbers = { static_cast<int>(input->sizeV()) };
+                densities = { n > 1 ? input->sizeE() / (n * (n - 1)) : 0 };
+            }
+
+            for (auto & density : densities)
+                for (auto & n : verticesNumbers)
+                {
+                    // Kazda komorka ma wlasne ziarno, wiec wszystkie reprezentacje mierzone sa na tych samych grafach
+                    const std::uint64_t seed = cellSeed(n, density);
+
+                    std::vector<Trial> trials(config.repetitions);
+                    std::vector<char> warmed(workers.size(), 0);
+
+                    // Liczniki mierza tylko watek, ktory je otworzyl, wiec kazdy watek tworzy wlasne
+                    std::vector<std::unique_ptr<PerfCounters>> counters(workers.size());
+
+                    auto task = [&](sizeType worker, sizeType k)
+                    {
+                        // Rozgrzewka wykonywana przez kazdy watek przed jego pierwsza mierzona proba
+                        if (!warmed[worker])
+                        {
+                            warmed[worker] = 1;
+                            if (config.counters)
+                                counters[worker].reset(new PerfCounters());
+                            for (sizeType j = 0; j < config.warmup; j++)
+                                runTrial(workers[worker], counters[worker].get(), n, density, mix(~seed + worker * config.warmup + j), nullptr);
+                        }
+                        runTrial(workers[worker], counters[worker].get(), n, density, mix(seed + k), &trials[k]);
+                    };
+
+                    if (workers.size() > 1)
+                        pool->parallelFor(config.repetitions, task);
+                    else
+                        for (sizeType k = 0; k < config.repetitions; k++)
+                            task(0, k);
+
+                    // Scalanie w kolejnosci prob, niezaleznie od kolejnosci wykonania
+                    std::vector<double> buildTimes;
+                    std::vector<double> queryTimes;
+                    std::vector<PerfSample> buildCounters;
+                    std::vector<PerfSample> queryCounters;
+                    buildTimes.reserve(config.repetitions);
+                    queryTimes.reserve(config.repetitions * config.queriesPerGraph);
+                    for (auto & t : trials)
+                    {
+                        buildTimes.push_back(t.build);
+                        queryTimes.insert(queryTimes.end(), t.queries.begin(), t.queries.end());
+                        buildCounters.push_back(t.buildCounters);
+                        queryCounters.insert(queryCounters.end(), t.queryCounters.begin(), t.queryCounters.end());
+                    }
+
+                    CountingStats work;
+                    sizeType workQueries = 0;
+                    for (auto & t : trials)
+                    {
+                        work += t.work;
+                        workQueries += t.workQueries;
+                    }
+
+                    BenchmarkResult result{ graphName, workers.front().query->name(), n, density, trials.empty() ? 0 : trials.front().edges,
+                                            BenchmarkStatistics::compute(buildTimes), BenchmarkStatistics::compute(queryTimes),
+                                            PerfSample::median(buildCounters), PerfSample::median(queryCounters), work, workQueries };
+                    resultsList.push_back(result);
+
+                    if (config.verbose)
+                    {
+                        std::cout << graphName << ' ' << result.query << " n=" << n << " d=" << density
+                                  << "  build median = " << result.buildTime.median << " ms"
+                                  << "  query median = " << result.queryTime.median << " ms"
+                                  << " (p99 = " << result.queryTime.p99 << " ms)";
+                        if (config.counters)
+                            std::cout << "  query cycles = " << result.queryCounters.values[0]
+                                      << "  instructions = " << result.queryCounters.values[1];
+                        if (result.workQueries)
+                            std::cout << "  relaxations = " << workPerQuery(result)[4];
+                        std::cout << std::endl;
+                    }
+                }
+        }
+
+        /// @brief Wczytuje graf z config.inputPath przy pierwszym uzyciu.
+        /// @return Zwraca falsz, jezeli pliku nie mozna wczytac.
+        bool loadInput()
+        {
+            if (input)
+                return true;
+            if (!pool)
+                pool.reset(new ThreadPool(config.threads, config.pinThreads));
+            std::unique_ptr<CSRGraph<int>> graph(new CSRGraph<int>());
+            GraphLoader loader(*pool);
+            if (!loader.load(config.inputPath, GraphLoader::detect(config.inputPath), *graph))
+                return false;
+            input = std::move(graph);
+            return true;
+        }
+
+        /// @brief Buduje graf i wykonuje na nim zapytania.
+        /// @param counters liczniki sprzetowe watku albo nullptr, jezeli sa wylaczone
+        /// @param trial miejsce na wyniki albo nullptr dla proby rozgrzewkowej
+        void runTrial(Worker& worker, PerfCounters* counters, const int& n, const double& density, const std::uint64_t& seed, Trial* trial)
+        {
+            TRACE_SPAN(trial ? "Benchmark::trial" : "Benchmark::warmup");
+            GraphADT<int,int>* graph = worker.graph;
+            GraphGenerator generator(seed);
+
+            // Liczniki uruchamiane sa poza odczytami zegara, aby wywolania systemowe nie wliczaly sie do czasu
+            if (counters)
+                counters->start();
+            auto buildStart = std::chrono::steady_clock::now();
+                graph->clear();
+                if (input)
+                    GraphLoader::insert(*input, graph);
+                else
+                    generator.simpleUndirected(graph, n, density);
+            auto buildEnd = std::chrono::steady_clock::now();
+            PerfSample buildCounters = counters ? counters->stop() : PerfSample();
+            if (trial)
+            {
+                trial->build = milliseconds(buildStart, buildEnd);
+                trial->edges = graph->sizeE();
+                trial->queries.reserve(config.queriesPerGraph);
+                trial->buildCounters = buildCounters;
+                if (counters)
+                    trial->queryCounters.reserve(config.queriesPerGraph);
+            }
+
+            if (graph->sizeV() == 0)
+                return;
+            worker.query->prepare(graph);
+
+            std::vector<const Vertex<int,int>*> endpoints;
+            for (sizeType q = 0; q < config.queriesPerGraph; q++)
+            {
+                const Vertex<int,int>* source = graph->vertex(generator.randomInt(0, graph->sizeV() - 1));
+                const Vertex<int,int>* target = graph->vertex(generator.randomInt(0, graph->sizeV() - 1));
+                if (trial && config.workStats)
+                {
+                    endpoints.push_back(source);
+                    endpoints.push_back(target);
+                }
+
+                if (counters)
+                    counters->start();
+                auto start = std::chrono::steady_clock::now();
+                    worker.query->run(graph, source, target);
+                auto end = std::chrono::steady_clock::now();
+                if (counters)
+                {
+                    PerfSample sample = counters->stop();
+                    if (trial)
+                        trial->queryCounters.push_back(sample);
+                }
+                if (trial)
+                    trial->queries.push_back(milliseconds(start, end));
+            }
+
+            // Zliczanie operacji po wszystkich pomiarach, aby dodatkowe wykonania nie rozgrzewaly pamieci podrecznej
+            if (!endpoints.empty())
+            {
+                TRACE_SPAN("Benchmark::profile");
+                for (sizeType q = 0; q + 1 < endpoints.size(); q += 2)
+                    if (worker.query->profile(graph, endpoints[q], endpoints[q + 1], trial->work))
+                        ++trial->workQueries;
+            }
+        }
+
+        /// @brief Funkcja mieszajaca splitmix64, uzywana do wyznaczania ziaren prob.
+        static std::uint64_t mix(std::uint64_t x)
+        {
+            x += 0x9E3779B97F4A7C15ull;
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+            return x ^ (x >> 31);
+        }
+
+        static double milliseconds(const std::chrono::steady_clock::time_point& start, const std::chrono::steady_clock::time_point& end)
+            { return std::chrono::duration<double, std::milli>(end - start).count(); }
+
+        std::uint64_t cellSeed(const int& n, const double& density) const
+            { return config.seed ^ (static_cast<std::uint64_t>(n) * 0x9E3779B97F4A7C15ull) ^ static_cast<std::uint64_t>(density * 1000003); }
+
+        static std::string quote(const std::string& text)
+        {
+            std::string out = "\"";
+            for (auto & c : text)
+            {
+                if (c == '"' || c == '\\')
+                    out += '\\';
+                if (static_cast<unsigned char>(c) >= 0x20)
+                    out += c;
+            }
+            return out + "\"";
+        }
+
+        static std::string statistics(const BenchmarkStatistics& s)
+        {
+            std::ostringstream out;
+            out.precision(9);
+            out << "{\"samples\": " << s.samples << ", \"min\": " << s.min << ", \"median\": " << s.median
+                << ", \"p95\": " << s.p95 << ", \"p99\": " << s.p99 << ", \"mean\": " << s.mean
+                << ", \"stddev\": " << s.stddev << "}";
+            return out.str();
+        }
+
+        static constexpr const char* WORK_NAMES[7] = { "pushes", "pops", "stale_pops", "decrease_keys",
+                                                       "relax_attempts", "relax_successes", "incident_edges_calls" };
+
+        /// @return Zwraca srednia liczbe operacji algorytmu na zapytanie, w kolejnosci WORK_NAMES.
+        static std::array<double, 7> workPerQuery(const BenchmarkResult& r)
+        {
+            const CountingStats& w = r.work;
+            const double q = r.workQueries ? static_cast<double>(r.workQueries) : 1.0;
+            return { w.pushes / q, w.pops / q, w.stalePops / q, w.decreaseKeys / q,
+                     w.relaxAttempts / q, w.relaxSuccesses / q, w.incidentEdgesCalls / q };
+        }
+
+        static std::string workValues(const BenchmarkResult& r)
+        {
+            if (!r.workQueries)
+                return "null";
+            std::ostringstream out;
+            out.precision(15);
+            std::array<double, 7> values = workPerQuery(r);
+            out << "{\"queries\": " << r.workQueries;
+            for (sizeType i = 0; i < values.size(); i++)
+                out << ", \"" << WORK_NAMES[i] << "\": " << values[i];
+            out << "}";
+            return out.str();
+        }
+
+        static std::string counterValues(const PerfSample& sample)
+        {
+            std::ostringstream out;
+            out.precision(15);
+            out << "{";
+            for (sizeType e = 0; e < PerfSample::EVENTS; e++)
+            {
+                out << (e ? ", \"" : "\"") << PerfSample::name(e) << "\": ";
+                if (sample.values[e] == sample.values[e])
+                    out << sample.values[e];
+                else
+                    out << "null";
+            }
+            out << "}";
+            return out.str();
+        }
+
+        BenchmarkConfig config;
+        MachineInfo machine;
+        std::vector<BenchmarkResult> resultsList;
+        std::unique_ptr<ThreadPool> pool;
+        std::unique_ptr<CSRGraph<int>> input;
+};
+
+#endif
@@ -0,0 +1,237 @@
+#ifndef BIDIRECTIONAL_DIJKSTRA_HPP
+#define BIDIRECTIONAL_DIJKSTRA_HPP
+
+#include <vector>
+#include <climits>
+#include <cstdint>
+#include <algorithm>
+
+#include "graph.hpp"
+#include "csr_graph.hpp"
+#include "priority_queue.hpp"
+#include "algorithm_stats.hpp"
+#include "trace.hpp"
+
+/// @brief Wynik zapytania o najkrotsza sciezke miedzy dwoma wierzcholkami.
+struct PointToPointResult
+{
+    // Dlugosc sciezki albo INT_MAX, jezeli wierzcholek docelowy jest nieosiagalny
+    int distance = INT_MAX;
+
+    // Indeksy kolejnych wierzcholkow sciezki od zrodla do celu (puste, jezeli cel jest nieosiagalny)
+    std::vector<sizeType> path;
+
+    // Liczba wierzcholkow zdjetych z obu kolejek
+    sizeType settled = 0;
+};
+
+/// @brief Dwukierunkowy algorytm Dijkstry dla zapytan punkt-punkt. Wyszukiwanie w przod (od zrodla) i wstecz
+/// (od celu) wykonywane jest na przemian, zawsze po stronie o mniejszym minimalnym kluczu, i konczy sie,
+/// gdy suma minimalnych kluczy obu kolejek osiagnie dlugosc najlepszej znalezionej sciezki.
+/// Obiekt przechowuje przestrzen robocza, ktora przywracana jest w czasie proporcjonalnym do liczby
+/// odwiedzonych wierzcholkow, wiec kolejne zapytania lokalne nie kosztuja O(V).
+/// Obsluguje tylko wagi int (brak sciezki to INT_MAX); grafy o innych wagach obsluguje DijkstraAlgorithm.
+/// @tparam Q kolejka priorytetowa adresowana indeksem wierzcholka (BinaryHeap, QuaternaryHeap, PairingHeap)
+template <template <typename> class Q = BinaryHeap>
+class BidirectionalDijkstraAlgorithm
+{
+    public:
+        /// @brief Dwukierunkowy algorytm Dijkstry.
+        /// @tparam T typ elementow na wierzcholkach
+        /// @param graph referencja do nieskierowanego grafu prostego z nieujemnymi wagami krawedzi
+        /// @param source referencja do wierzcholka poczatkowego
+        /// @param target referencja do wierzcholka docelowego
+        /// @return Zwraca dlugosc i przebieg najkrotszej sciezki.
+        template <typename T>
+        PointToPointResult shortestPath(const GraphADT<T,int>* graph, const Vertex<T,int>* source, const Vertex<T,int>* target)
+        {
+            NoStats stats;
+            return shortestPath(graph, source, target, stats);
+        }
+
+        /// @brief Dwukierunkowy algorytm Dijkstry zliczajacy wykonane operacje.
+        /// @tparam T typ elementow na wierzcholkach
+        /// @tparam S polityka statystyk (NoStats, CountingStats)
+        /// @param graph referencja do nieskierowanego grafu prostego z nieujemnymi wagami krawedzi
+        /// @param source referencja do wierzcholka poczatkowego
+        /// @param target referencja do wierzcholka docelowego
+        /// @param stats statystyki, do ktorych dopisywane sa operacje algorytmu
+        /// @return Zwraca dlugosc i przebieg najkrotszej sciezki.
+        template <typename T, typename S>
+        PointToPointResult shortestPath(const GraphADT<T,int>* graph, const Vertex<T,int>* source, const Vertex<T,int>* target, S& stats)
+        {
+            TRACE_SPAN("BidirectionalDijkstraAlgorithm::shortestPath");
+            auto neighbours = [graph](const sizeType& u, auto&& visit)
+            {
+                const Vertex<T,int>* vu = graph->vertex(u);
+                for (auto e : graph->incidentEdgesRange(vu))
+                    visit(graph->opposite(vu, e)->i, e->element);
+            };
+            return search(graph->sizeV(), source->i, target->i, neighbours, stats);
+        }
+
+        /// @brief Dwukierunkowy algorytm Dijkstry dla grafu w formacie CSR.
+        /// @param graph widok grafu w formacie CSR (CSRGraph, MappedGraph albo CSRView) z nieujemnymi wagami krawedzi
+        /// @param source indeks wierzcholka poczatkowego
+        /// @param target indeks wierzcholka docelowego
+        /// @return Zwraca dlugosc i przebieg najkrotszej sciezki.
+        PointToPointResult shortestPath(const CSRView<int>& graph, const sizeType& source, const sizeType& target)
+        {
+            NoStats stats;
+            return shortestPath(graph, source, target, stats);
+        }
+
+        /// @brief Dwukierunkowy algorytm Dijkstry dla grafu w formacie CSR, zliczajacy wykonane operacje.
+        /// @tparam S polityka statystyk (NoStats, CountingStats)
+        /// @param graph widok grafu w formacie CSR (CSRGraph, MappedGraph albo CSRView) z nieujemnymi wagami krawedzi
+        /// @param source indeks wierzcholka poczatkowego
+        /// @param target indeks wierzcholka docelowego
+        /// @param stats statystyki, do ktorych dopisywane sa operacje algorytmu
+        /// @return Zwraca dlugosc i przebieg najkrotszej sciezki.
+        template <typename S>
+        PointToPointResult shortestPath(const CSRView<int>& graph, const sizeType& source, const sizeType& target, S& stats)
+        {
+            TRACE_SPAN("BidirectionalDijkstraAlgorithm::shortestPath(CSR)");
+            auto neighbours = [&graph](const sizeType& u, auto&& visit)
+            {
+                for (sizeType k = graph.offset(u); k < graph.offset(u + 1); k++)
+                    visit(graph.target(k), graph.weight(k));
+            };
+            return search(graph.sizeV(), source, target, neighbours, stats);
+        }
+
+    private:
+        static constexpr std::uint32_t NONE = UINT32_MAX;
+
+        /// @brief Stan wyszukiwania w jednym kierunku.
+        struct Side
+        {
+            std::vector<int> D;
+            std::vector<std::uint32_t> parent;
+            std::vector<char> settled;
+            std::vector<std::uint32_t> touched;
+            Q<int> queue;
+
+            void resize(const sizeType& n)
+            {
+                D.assign(n, INT_MAX);
+                parent.assign(n, NONE);
+                settled.assign(n, 0);
+                touched.clear();
+                queue.resize(n);
+            }
+
+            /// @brief Przywraca stan poczatkowy odwiedzonych wierzcholkow.
+            void reset()
+            {
+                for (auto & i : touched)
+                {
+                    D[i] = INT_MAX;
+                    parent[i] = NONE;
+                    settled[i] = 0;
+                }
+                touched.clear();
+                queue.clear();
+            }
+
+            void start(const sizeType& v)
+            {
+                D[v] = 0;
+                touched.push_back(static_cast<std::uint32_t>(v));
+                queue.push(v, 0);
+            }
+        };
+
+        template <typename N, typename S>
+        PointToPointResult search(const sizeType& n, const sizeType& source, const sizeType& target, const N& neighbours, S& stats)
+        {
+            if (forward.D.size() != n)
+            {
+                forward.resize(n);
+                backward.resize(n);
+            }
+
+            PointToPointResult result;
+            if (source == target)
+            {
+                result.distance = 0;
+                result.path.push_back(source);
+                return result;
+            }
+
+            forward.start(source);
+            backward.start(target);
+            stats.push();
+            stats.push();
+
+            // Najlepsza znaleziona sciezka: krawedz (meetForward, meetBackward) laczaca oba drzewa
+            std::int64_t best = INT_MAX;
+            sizeType meetForward = n;
+            sizeType meetBackward = n;
+
+            while (!forward.queue.empty() && !backward.queue.empty())
+            {
+                if (static_cast<std::int64_t>(forward.queue.topKey()) + backward.queue.topKey() >= best)
+                    break;
+
+                const bool isForward = forward.queue.topKey() <= backward.queue.topKey();
+                Side& side = isForward ? forward : backward;
+                Side& other = isForward ? backward : forward;
+
+                const sizeType u = side.queue.top();
+                side.queue.pop();
+                side.settled[u] = 1;
+                ++result.settled;
+                stats.pop();
+                stats.incidentEdges();
+
+                const int du = side.D[u];
+                neighbours(u, [&](const sizeType& z, const int& w)
+                {
+                    stats.relaxAttempt();
+                    if (!side.settled[z] && w < side.D[z] - du)
+                    {
+                        if (side.D[z] == INT_MAX)
+                            side.touched.push_back(static_cast<std::uint32_t>(z));
+                        side.D[z] = du + w;
+                        side.parent[z] = static_cast<std::uint32_t>(u);
+                        stats.relaxSuccess();
+                        if constexpr (S::enabled)
+                        {
+                            if (side.queue.contains(z))
+                                stats.decreaseKey();
+                            else
+                                stats.push();
+                        }
+                        side.queue.pushOrDecrease(z, side.D[z]);
+                    }
+
+                    if (other.D[z] != INT_MAX && static_cast<std::int64_t>(du) + w + other.D[z] < best)
+                    {
+                        best = static_cast<std::int64_t>(du) + w + other.D[z];
+                        meetForward = isForward ? u : z;
+                        meetBackward = isForward ? z : u;
+                    }
+                });
+            }
+
+            if (best < INT_MAX)
+            {
+                result.distance = static_cast<int>(best);
+                for (sizeType x = meetForward; x != NONE; x = forward.parent[x])
+                    result.path.push_back(x);
+                std::reverse(result.path.begin(), result.path.end());
+                for (sizeType x = meetBackward; x != NONE; x = backward.parent[x])
+                    result.path.push_back(x);
+            }
+
+            forward.reset();
+            backward.reset();
+            return result;
+        }
+
+        Side forward;
+        Side backward;
+};
+
+#endif
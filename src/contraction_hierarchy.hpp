@@ -0,0 +1,591 @@
+#ifndef CONTRACTION_HIERARCHY_HPP
+#define CONTRACTION_HIERARCHY_HPP
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+#include "graph.hpp"
+#include "csr_graph.hpp"
+#include "priority_queue.hpp"
+#include "algorithm_stats.hpp"
+#include "bidirectional_dijkstra.hpp"
+#include "trace.hpp"
+
+/// @brief Hierarchia skrotow (Contraction Hierarchies, Geisberger i in.) dla zapytan punkt-punkt na statycznych grafach.
+/// Przetwarzanie wstepne kontraktuje wierzcholki w kolejnosci priorytetu (roznica krawedzi + liczba
+/// skontraktowanych sasiadow, z leniwa aktualizacja), dodajac skrot u-w przez v, jezeli wyszukiwanie swiadka
+/// nie znajdzie sciezki omijajacej v. Hierarchia zapisywana jest jako CSR krawedzi w gore (do wierzcholkow
+/// o wyzszej randze). Graf jest nieskierowany, wiec graf krawedzi w dol jest transpozycja grafu w gore i obie
+/// strony zapytania przegladaja te same tablice. Zapytanie to dwukierunkowy algorytm Dijkstry po krawedziach
+/// w gore, a znaleziona sciezka rozwijana jest rekurencyjnie przez wierzcholki srodkowe skrotow.
+/// Kontrakcja konczy sie, gdy sredni stopien pozostalego grafu przekroczy prog. Pozostale wierzcholki tworza rdzen
+/// na szczycie hierarchii i zachowuja wszystkie krawedzie miedzy soba, wiec w rdzeniu zapytanie dziala jak zwykly
+/// dwukierunkowy algorytm Dijkstry. Zapobiega to kwadratowemu wzrostowi liczby skrotow w grafach bez struktury
+/// hierarchicznej (grafy losowe i geste), dla ktorych rdzen obejmuje wiekszosc wierzcholkow.
+/// Wagi krawedzi i skrotow sa typu int, rowniez w formacie pliku hierarchii.
+/// @tparam Q kolejka priorytetowa adresowana indeksem wierzcholka (BinaryHeap, QuaternaryHeap, PairingHeap)
+template <template <typename> class Q = BinaryHeap>
+class ContractionHierarchy
+{
+    public:
+        /// @brief Najwieksza liczba wierzcholkow zdejmowanych z kolejki w jednym wyszukiwaniu swiadka. Po przekroczeniu
+        /// limitu skrot jest dodawany, co nie wplywa na poprawnosc, a jedynie na rozmiar hierarchii.
+        static constexpr sizeType witnessLimit = 500;
+
+        /// @brief Limit wyszukiwania swiadka przy wyznaczaniu priorytetu. Priorytet jest tylko oszacowaniem, wiec
+        /// krotsze wyszukiwanie wystarcza, a obliczany jest wielokrotnie dla kazdego wierzcholka.
+        static constexpr sizeType simulationLimit = 50;
+
+        ContractionHierarchy() = default;
+
+        /// @brief Buduje hierarchie dla grafu w formacie CSR.
+        /// @param graph widok grafu w formacie CSR (CSRGraph, MappedGraph albo CSRView) z nieujemnymi wagami krawedzi
+        /// @param coreDegree sredni stopien pozostalego grafu, po przekroczeniu ktorego kontrakcja jest przerywana (0 - bez rdzenia)
+        void build(const CSRView<int>& graph, const double& coreDegree = 32)
+        {
+            TRACE_SPAN("ContractionHierarchy::build");
+            const sizeType n = graph.sizeV();
+            Contraction c;
+            c.adjacency.resize(n);
+            c.deleted.assign(n, 0);
+            c.D.assign(n, INT_MAX);
+            c.target.assign(n, 0);
+            c.queue.resize(n);
+            for (sizeType v = 0; v < n; v++)
+                for (sizeType k = graph.offset(v); k < graph.offset(v + 1); k++)
+                    if (graph.target(k) != v)
+                        addArc(c, v, graph.target(k), graph.weight(k), NONE);
+
+            rank.assign(n, 0);
+            shortcutCount = 0;
+            Q<int> order;
+            order.resize(n);
+            // Priorytety poczatkowe nie sa potrzebne, jezeli caly graf zostaje rdzeniem
+            const bool contracting = coreDegree <= 0 || c.arcs <= coreDegree * n;
+            for (sizeType v = 0; v < n; v++)
+                order.push(v, contracting ? priority(c, v) : 0);
+
+            sizeType next = 0;
+            while (!order.empty())
+            {
+                if (coreDegree > 0 && c.arcs > coreDegree * order.size())
+                    break;
+
+                const sizeType v = order.top();
+                order.pop();
+
+                // Leniwa aktualizacja: priorytet przeliczany jest dopiero przy zdjeciu z kolejki, a wierzcholek wraca
+                // do kolejki, jezeli po kontrakcji sasiadow nie jest juz najmniejszy
+                const int p = priority(c, v);
+                if (!order.empty() && p > order.topKey())
+                {
+                    order.push(v, p);
+                    continue;
+                }
+
+                contract(c, v);
+                rank[v] = static_cast<std::uint32_t>(next++);
+            }
+
+            // Wierzcholki rdzenia otrzymuja najwyzsze rangi w dowolnej kolejnosci
+            coreStart = next;
+            for (; !order.empty(); order.pop())
+                rank[order.top()] = static_cast<std::uint32_t>(next++);
+
+            // Po kontrakcji lista wierzcholka zawiera dokladnie jego krawedzie w gore, a lista wierzcholka rdzenia
+            // wszystkie krawedzie do pozostalych wierzcholkow rdzenia
+            std::vector<sizeType> offsets(n + 1, 0);
+            for (sizeType v = 0; v < n; v++)
+                offsets[v + 1] = offsets[v] + c.adjacency[v].size();
+            std::vector<std::uint32_t> targets(offsets[n]);
+            std::vector<int> weights(offsets[n]);
+            middles.assign(offsets[n], NONE);
+            for (sizeType v = 0; v < n; v++)
+            {
+                sizeType k = offsets[v];
+                for (auto & a : c.adjacency[v])
+                {
+                    targets[k] = a.target;
+                    weights[k] = a.weight;
+                    middles[k] = a.middle;
+                    ++k;
+                }
+            }
+            upward = CSRGraph<int>(std::move(offsets), std::move(targets), std::move(weights));
+            resetWorkspace();
+        }
+
+        /// @brief Buduje hierarchie. Graf zamieniany jest najpierw na migawke CSR.
+        /// @tparam T typ elementow na wierzcholkach
+        /// @param graph referencja do nieskierowanego grafu prostego z nieujemnymi wagami krawedzi
+        /// @param coreDegree sredni stopien pozostalego grafu, po przekroczeniu ktorego kontrakcja jest przerywana (0 - bez rdzenia)
+        template <typename T>
+        void build(const GraphADT<T,int>* graph, const double& coreDegree = 32)
+            { build(graph->freeze(), coreDegree); }
+
+        /// @return Zwraca liczbe wierzcholkow hierarchii.
+        sizeType sizeV() const
+            { return rank.size(); }
+
+        /// @return Zwraca liczbe krawedzi w gore (krawedzie grafu i skroty).
+        sizeType sizeE() const
+            { return upward.sizeE(); }
+
+        /// @return Zwraca liczbe dodanych skrotow.
+        sizeType shortcuts() const
+            { return shortcutCount; }
+
+        /// @return Zwraca liczbe nieskontraktowanych wierzcholkow rdzenia.
+        sizeType coreSize() const
+            { return sizeV() - coreStart; }
+
+        /// @param v indeks wierzcholka
+        /// @return Zwraca pozycje wierzcholka w kolejnosci kontrakcji.
+        sizeType level(const sizeType& v) const
+            { return rank[v]; }
+
+        /// @brief Zapytanie o najkrotsza sciezke w hierarchii.
+        /// @param source indeks wierzcholka poczatkowego
+        /// @param target indeks wierzcholka docelowego
+        /// @return Zwraca dlugosc i przebieg najkrotszej sciezki w grafie wejsciowym oraz liczbe zdjetych z kolejek wierzcholkow.
+        PointToPointResult shortestPath(const sizeType& source, const sizeType& target)
+        {
+            NoStats stats;
+            return shortestPath(source, target, stats);
+        }
+
+        /// @brief Zapytanie o najkrotsza sciezke w hierarchii, zliczajace wykonane operacje.
+        /// @tparam S polityka statystyk (NoStats, CountingStats)
+        /// @param source indeks wierzcholka poczatkowego
+        /// @param target indeks wierzcholka docelowego
+        /// @param stats statystyki, do ktorych dopisywane sa operacje algorytmu
+        /// @return Zwraca dlugosc i przebieg najkrotszej sciezki w grafie wejsciowym oraz liczbe zdjetych z kolejek wierzcholkow.
+        template <typename S>
+        PointToPointResult shortestPath(const sizeType& source, const sizeType& target, S& stats)
+        {
+            TRACE_SPAN("ContractionHierarchy::shortestPath");
+            if (forward.D.size() != sizeV())
+                resetWorkspace();
+
+            PointToPointResult result;
+            if (source == target)
+            {
+                result.distance = 0;
+                result.path.push_back(source);
+                return result;
+            }
+
+            forward.start(source);
+            backward.start(target);
+            stats.push();
+            stats.push();
+
+            std::int64_t best = INT_MAX;
+            sizeType meet = sizeV();
+            while (!forward.queue.empty() || !backward.queue.empty())
+            {
+                const bool isForward = backward.queue.empty() ||
+                                       (!forward.queue.empty() && forward.queue.topKey() <= backward.queue.topKey());
+                Side& side = isForward ? forward : backward;
+                Side& other = isForward ? backward : forward;
+
+                // Klucze obu kolejek sa nie mniejsze od najlepszej sciezki
+                if (side.queue.topKey() >= best)
+                    break;
+
+                const sizeType u = side.queue.top();
+                side.queue.pop();
+                ++result.settled;
+                stats.pop();
+                stats.incidentEdges();
+
+                const int du = side.D[u];
+                if (other.D[u] != INT_MAX && static_cast<std::int64_t>(du) + other.D[u] < best)
+                {
+                    best = static_cast<std::int64_t>(du) + other.D[u];
+                    meet = u;
+                }
+
+                for (sizeType k = upward.offset(u); k < upward.offset(u + 1); k++)
+                {
+                    const sizeType z = upward.target(k);
+                    const int w = upward.weight(k);
+                    stats.relaxAttempt();
+                    if (w < side.D[z] - du)
+                    {
+                        if (side.D[z] == INT_MAX)
+                            side.touched.push_back(static_cast<std::uint32_t>(z));
+                        side.D[z] = du + w;
+                        side.parent[z] = static_cast<std::uint32_t>(u);
+                        stats.relaxSuccess();
+                        if constexpr (S::enabled)
+                        {
+                            if (side.queue.contains(z))
+                                stats.decreaseKey();
+                            else
+                                stats.push();
+                        }
+                        side.queue.pushOrDecrease(z, side.D[z]);
+                    }
+                }
+            }
+
+            if (best < INT_MAX)
+            {
+                result.distance = static_cast<int>(best);
+                std::vector<sizeType> hierarchy;
+                for (sizeType x = meet; x != NONE; x = forward.parent[x])
+                    hierarchy.push_back(x);
+                std::reverse(hierarchy.begin(), hierarchy.end());
+                for (sizeType x = backward.parent[meet]; x != NONE; x = backward.parent[x])
+                    hierarchy.push_back(x);
+
+                result.path.push_back(hierarchy.front());
+                for (sizeType i = 1; i < hierarchy.size(); i++)
+                    unpack(hierarchy[i - 1], hierarchy[i], result.path);
+            }
+
+            forward.reset();
+            backward.reset();
+            return result;
+        }
+
+        /// @brief Zapytanie o najkrotsza sciezke w hierarchii zbudowanej dla tego grafu.
+        /// @tparam T typ elementow na wierzcholkach
+        /// @param graph referencja do grafu, dla ktorego zbudowano hierarchie
+        /// @param source referencja do wierzcholka poczatkowego
+        /// @param target referencja do wierzcholka docelowego
+        /// @return Zwraca dlugosc i przebieg najkrotszej sciezki oraz liczbe zdjetych z kolejek wierzcholkow.
+        template <typename T>
+        PointToPointResult shortestPath(const GraphADT<T,int>* /*graph*/, const Vertex<T,int>* source, const Vertex<T,int>* target)
+            { return shortestPath(source->i, target->i); }
+
+        /// @brief Zapytanie o najkrotsza sciezke w hierarchii zbudowanej dla tego grafu, zliczajace wykonane operacje.
+        /// @tparam T typ elementow na wierzcholkach
+        /// @tparam S polityka statystyk (NoStats, CountingStats)
+        /// @param graph referencja do grafu, dla ktorego zbudowano hierarchie
+        /// @param source referencja do wierzcholka poczatkowego
+        /// @param target referencja do wierzcholka docelowego
+        /// @param stats statystyki, do ktorych dopisywane sa operacje algorytmu
+        /// @return Zwraca dlugosc i przebieg najkrotszej sciezki oraz liczbe zdjetych z kolejek wierzcholkow.
+        template <typename T, typename S>
+        PointToPointResult shortestPath(const GraphADT<T,int>* /*graph*/, const Vertex<T,int>* source, const Vertex<T,int>* target, S& stats)
+            { return shortestPath(source->i, target->i, stats); }
+
+        /// @brief Zapisuje hierarchie do pliku binarnego (natywna kolejnosc bajtow).
+        /// @param filePath sciezka do pliku
+        /// @return Zwraca falsz, jezeli zapis sie nie powiodl.
+        bool save(const std::string& filePath) const
+        {
+            TRACE_SPAN("ContractionHierarchy::save");
+            std::ofstream output(filePath, std::ios::binary);
+            const std::uint64_t header[] = { sizeV(), sizeE(), shortcutCount, coreStart };
+            output.write(MAGIC, sizeof(MAGIC));
+            output.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+            output.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+            std::vector<std::uint64_t> offsets(sizeV() + 1);
+            std::vector<std::uint32_t> targets(sizeE());
+            std::vector<std::int32_t> weights(sizeE());
+            for (sizeType v = 0; v <= sizeV(); v++)
+                offsets[v] = upward.offset(v);
+            for (sizeType k = 0; k < sizeE(); k++)
+            {
+                targets[k] = upward.target(k);
+                weights[k] = upward.weight(k);
+            }
+            write(output, rank);
+            write(output, offsets);
+            write(output, targets);
+            write(output, weights);
+            write(output, middles);
+            return static_cast<bool>(output);
+        }
+
+        /// @brief Wczytuje hierarchie zapisana przez save().
+        /// @param filePath sciezka do pliku
+        /// @return Zwraca falsz, jezeli plik nie istnieje, ma inna wersje lub jest uszkodzony; hierarchia pozostaje wtedy pusta.
+        bool load(const std::string& filePath)
+        {
+            TRACE_SPAN("ContractionHierarchy::load");
+            *this = ContractionHierarchy();
+            std::ifstream input(filePath, std::ios::binary);
+            char magic[sizeof(MAGIC)];
+            std::uint32_t version = 0;
+            std::uint64_t header[4];
+            input.read(magic, sizeof(magic));
+            input.read(reinterpret_cast<char*>(&version), sizeof(version));
+            input.read(reinterpret_cast<char*>(header), sizeof(header));
+            if (!input || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION || header[0] >= NONE || header[3] > header[0])
+                return false;
+
+            const sizeType n = header[0];
+            const sizeType m = header[1];
+
+            // Rozmiar pliku sprawdzany przed alokacja tablic o rozmiarach z naglowka
+            const std::streamoff start = input.tellg();
+            input.seekg(0, std::ios::end);
+            const std::uint64_t remaining = static_cast<std::uint64_t>(input.tellg() - start);
+            input.seekg(start);
+            if (m > remaining || remaining != 4 * n + 8 * (n + 1) + 12 * m)
+                return false;
+
+            std::vector<std::uint32_t> levels(n);
+            std::vector<std::uint64_t> offsets(n + 1);
+            std::vector<std::uint32_t> targets(m);
+            std::vector<std::int32_t> weights(m);
+            std::vector<std::uint32_t> centres(m);
+            if (!read(input, levels) || !read(input, offsets) || !read(input, targets) || !read(input, weights) || !read(input, centres))
+                return false;
+
+            // Kontrola spojnosci: rosnace przesuniecia, poprawne indeksy i krawedzie w gore albo wewnatrz rdzenia
+            const sizeType core = header[3];
+            if (offsets[0] != 0 || offsets[n] != m)
+                return false;
+            for (sizeType v = 0; v < n; v++)
+            {
+                if (levels[v] >= n || offsets[v] > offsets[v + 1])
+                    return false;
+                for (sizeType k = offsets[v]; k < offsets[v + 1]; k++)
+                    if (targets[k] >= n || (levels[targets[k]] <= levels[v] && levels[v] < core) || weights[k] < 0 || (centres[k] != NONE && centres[k] >= n))
+                        return false;
+            }
+
+            rank = std::move(levels);
+            middles = std::move(centres);
+            shortcutCount = header[2];
+            coreStart = header[3];
+            upward = CSRGraph<int>(std::vector<sizeType>(offsets.begin(), offsets.end()), std::move(targets),
+                                   std::vector<int>(weights.begin(), weights.end()));
+            resetWorkspace();
+            return true;
+        }
+
+    private:
+        static constexpr std::uint32_t NONE = UINT32_MAX;
+        static constexpr char MAGIC[4] = { 'G', 'C', 'H', 'F' };
+        static constexpr std::uint32_t VERSION = 1;
+
+        /// @brief Krawedz grafu w trakcie kontrakcji; middle to wierzcholek srodkowy skrotu albo NONE.
+        struct Arc
+        {
+            std::uint32_t target;
+            int weight;
+            std::uint32_t middle;
+        };
+
+        /// @brief Skrot oczekujacy na dodanie po kontrakcji wierzcholka.
+        struct Shortcut
+        {
+            std::uint32_t from;
+            std::uint32_t to;
+            int weight;
+        };
+
+        /// @brief Stan przetwarzania wstepnego: graf pozostalych wierzcholkow i przestrzen robocza wyszukiwania swiadkow.
+        struct Contraction
+        {
+            std::vector<std::vector<Arc>> adjacency;
+            sizeType arcs = 0;
+            std::vector<int> deleted;
+            std::vector<int> D;
+            std::vector<char> target;
+            std::vector<std::uint32_t> touched;
+            std::vector<Shortcut> pending;
+            Q<int> queue;
+        };
+
+        /// @brief Stan wyszukiwania w jednym kierunku zapytania.
+        struct Side
+        {
+            std::vector<int> D;
+            std::vector<std::uint32_t> parent;
+            std::vector<std::uint32_t> touched;
+            Q<int> queue;
+
+            void resize(const sizeType& n)
+            {
+                D.assign(n, INT_MAX);
+                parent.assign(n, NONE);
+                touched.clear();
+                queue.resize(n);
+            }
+
+            /// @brief Przywraca stan poczatkowy odwiedzonych wierzcholkow.
+            void reset()
+            {
+                for (auto & i : touched)
+                {
+                    D[i] = INT_MAX;
+                    parent[i] = NONE;
+                }
+                touched.clear();
+                queue.clear();
+            }
+
+            void start(const sizeType& v)
+            {
+                D[v] = 0;
+                touched.push_back(static_cast<std::uint32_t>(v));
+                queue.push(v, 0);
+            }
+        };
+
+        void resetWorkspace()
+        {
+            forward.resize(sizeV());
+            backward.resize(sizeV());
+        }
+
+        /// @brief Dodaje krawedz u-v albo skraca istniejaca.
+        static void addArc(Contraction& c, const sizeType& u, const sizeType& v, const int& weight, const std::uint32_t& middle)
+        {
+            for (auto & a : c.adjacency[u])
+                if (a.target == v)
+                {
+                    if (weight < a.weight)
+                    {
+                        a.weight = weight;
+                        a.middle = middle;
+                    }
+                    return;
+                }
+            c.adjacency[u].push_back(Arc{ static_cast<std::uint32_t>(v), weight, middle });
+            ++c.arcs;
+        }
+
+        /// @brief Wyznacza skroty potrzebne po usunieciu v i zapisuje je w c.pending. Dla kazdego sasiada u
+        /// wykonywane jest jedno ograniczone wyszukiwanie z pominieciem v, obejmujace wszystkich dalszych sasiadow.
+        static void witnesses(Contraction& c, const sizeType& v, const sizeType& settledLimit)
+        {
+            c.pending.clear();
+            const std::vector<Arc>& around = c.adjacency[v];
+            for (sizeType i = 0; i + 1 < around.size(); i++)
+            {
+                const sizeType u = around[i].target;
+                std::int64_t limit = 0;
+                sizeType remaining = around.size() - i - 1;
+                for (sizeType j = i + 1; j < around.size(); j++)
+                {
+                    limit = std::max<std::int64_t>(limit, static_cast<std::int64_t>(around[i].weight) + around[j].weight);
+                    c.target[around[j].target] = 1;
+                }
+
+                c.D[u] = 0;
+                c.touched.push_back(static_cast<std::uint32_t>(u));
+                c.queue.push(u, 0);
+                sizeType settled = 0;
+                // Wyszukiwanie konczy sie po zdjeciu wszystkich celow, przekroczeniu limitu odleglosci albo liczby wierzcholkow
+                while (remaining && !c.queue.empty() && c.queue.topKey() <= limit && settled < settledLimit)
+                {
+                    const sizeType x = c.queue.top();
+                    c.queue.pop();
+                    ++settled;
+                    if (c.target[x])
+                        --remaining;
+                    const int dx = c.D[x];
+                    for (auto & a : c.adjacency[x])
+                        if (a.target != v && a.weight < c.D[a.target] - dx)
+                        {
+                            if (c.D[a.target] == INT_MAX)
+                                c.touched.push_back(a.target);
+                            c.D[a.target] = dx + a.weight;
+                            c.queue.pushOrDecrease(a.target, c.D[a.target]);
+                        }
+                }
+
+                for (sizeType j = i + 1; j < around.size(); j++)
+                {
+                    c.target[around[j].target] = 0;
+                    const std::int64_t via = static_cast<std::int64_t>(around[i].weight) + around[j].weight;
+                    // Sciezki dluzsze niz INT_MAX nie sa reprezentowane, tak jak w DijkstraAlgorithm
+                    if (via < INT_MAX && c.D[around[j].target] > via)
+                        c.pending.push_back(Shortcut{ static_cast<std::uint32_t>(u), around[j].target, static_cast<int>(via) });
+                }
+
+                for (auto & x : c.touched)
+                    c.D[x] = INT_MAX;
+                c.touched.clear();
+                c.queue.clear();
+            }
+        }
+
+        /// @return Zwraca priorytet kontrakcji: liczba skrotow - stopien + liczba skontraktowanych sasiadow.
+        static int priority(Contraction& c, const sizeType& v)
+        {
+            witnesses(c, v, simulationLimit);
+            return static_cast<int>(c.pending.size()) - static_cast<int>(c.adjacency[v].size()) + c.deleted[v];
+        }
+
+        /// @brief Usuwa v z grafu pozostalych wierzcholkow i dodaje potrzebne skroty. Lista v pozostaje
+        /// niezmieniona i zawiera krawedzie w gore hierarchii.
+        void contract(Contraction& c, const sizeType& v)
+        {
+            witnesses(c, v, witnessLimit);
+            for (auto & a : c.adjacency[v])
+            {
+                std::vector<Arc>& list = c.adjacency[a.target];
+                for (sizeType k = 0; k < list.size(); k++)
+                    if (list[k].target == v)
+                    {
+                        list[k] = list.back();
+                        list.pop_back();
+                        break;
+                    }
+                ++c.deleted[a.target];
+            }
+            c.arcs -= 2 * c.adjacency[v].size();
+            for (auto & s : c.pending)
+            {
+                addArc(c, s.from, s.to, s.weight, static_cast<std::uint32_t>(v));
+                addArc(c, s.to, s.from, s.weight, static_cast<std::uint32_t>(v));
+            }
+            shortcutCount += c.pending.size();
+        }
+
+        /// @brief Dopisuje do sciezki wierzcholki krawedzi hierarchii a-b (bez a), rozwijajac skroty.
+        void unpack(const sizeType& a, const sizeType& b, std::vector<sizeType>& path) const
+        {
+            const sizeType low = rank[a] < rank[b] ? a : b;
+            const sizeType high = low == a ? b : a;
+            std::uint32_t middle = NONE;
+            for (sizeType k = upward.offset(low); k < upward.offset(low + 1); k++)
+                if (upward.target(k) == high)
+                {
+                    middle = middles[k];
+                    break;
+                }
+
+            if (middle == NONE)
+                path.push_back(b);
+            else
+            {
+                unpack(a, middle, path);
+                unpack(middle, b, path);
+            }
+        }
+
+        template <typename X>
+        static void write(std::ofstream& output, const std::vector<X>& data)
+            { output.write(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(X)); }
+
+        template <typename X>
+        static bool read(std::ifstream& input, std::vector<X>& data)
+            { return static_cast<bool>(input.read(reinterpret_cast<char*>(data.data()), data.size() * sizeof(X))); }
+
+        std::vector<std::uint32_t> rank;
+        CSRGraph<int> upward;
+        std::vector<std::uint32_t> middles;
+        sizeType shortcutCount = 0;
+        sizeType coreStart = 0;
+
+        Side forward;
+        Side backward;
+};
+
+#endif
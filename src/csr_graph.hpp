@@ -0,0 +1,256 @@
+#ifndef CSR_GRAPH_HPP
+#define CSR_GRAPH_HPP
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+
+#include "types.hpp"
+#include "trace.hpp"
+
+/// @brief Widok tablic CSR przechowywanych w cudzej pamieci (CSRGraph, plik odwzorowany w pamieci), bez kopiowania.
+/// Udostepnia te same metody dostepu co CSRGraph i jest wazny tak dlugo, jak pamiec, na ktora wskazuje.
+/// @tparam W typ danych na krawedziach grafu
+template <typename W>
+class CSRView
+{
+    public:
+        CSRView() = default;
+
+        /// @brief Konstruktor widoku.
+        /// @param vertices liczba wierzcholkow
+        /// @param offsets tablica przesuniec o rozmiarze vertices + 1
+        /// @param targets indeksy wierzcholkow sasiednich (offsets[vertices] elementow)
+        /// @param weights wagi krawedzi, rownolegle do tablicy targets
+        CSRView(const sizeType& vertices, const sizeType* offsets, const std::uint32_t* targets, const W* weights):
+            vertices{vertices}, offsets{offsets}, targets{targets}, weights{weights} {}
+
+        /// @return Zwraca liczbe wierzcholkow.
+        sizeType sizeV() const
+            { return vertices; }
+
+        /// @return Zwraca liczbe wpisow w tablicy sasiadow (dwukrotnosc liczby krawedzi nieskierowanych).
+        sizeType sizeE() const
+            { return vertices ? offsets[vertices] : 0; }
+
+        /// @param v indeks wierzcholka
+        /// @return Zwraca stopien wierzcholka.
+        sizeType degree(const sizeType& v) const
+            { return offsets[v + 1] - offsets[v]; }
+
+        /// @param v indeks wierzcholka (dopuszczalne v == sizeV())
+        /// @return Zwraca indeks pierwszego sasiada wierzcholka w tablicach celow i wag.
+        sizeType offset(const sizeType& v) const
+            { return offsets[v]; }
+
+        /// @param k indeks wpisu w tablicy sasiadow
+        /// @return Zwraca indeks wierzcholka sasiedniego.
+        std::uint32_t target(const sizeType& k) const
+            { return targets[k]; }
+
+        /// @param k indeks wpisu w tablicy sasiadow
+        /// @return Zwraca wage krawedzi.
+        const W& weight(const sizeType& k) const
+            { return weights[k]; }
+
+    private:
+        sizeType vertices = 0;
+        const sizeType* offsets = nullptr;
+        const std::uint32_t* targets = nullptr;
+        const W* weights = nullptr;
+};
+
+/// @brief Niemodyfikowalna migawka grafu w formacie CSR (compressed sparse row).
+/// Sasiedzi wierzcholka v zajmuja przedzial [offset(v), offset(v + 1)) tablic celow i wag.
+/// Kazda krawedz nieskierowana zapisana jest dwukrotnie, raz dla kazdego wierzcholka koncowego.
+/// @tparam W typ danych na krawedziach grafu
+template <typename W>
+class CSRGraph
+{
+    public:
+        CSRGraph(): offsets(1, 0) {}
+
+        /// @brief Konstruktor przejmujacy gotowe tablice CSR.
+        /// @param offsets tablica przesuniec o rozmiarze liczba wierzcholkow + 1
+        /// @param targets indeksy wierzcholkow sasiednich
+        /// @param weights wagi krawedzi, rownolegle do tablicy targets
+        CSRGraph(std::vector<sizeType> offsets, std::vector<std::uint32_t> targets, std::vector<W> weights):
+            offsets{std::move(offsets)}, targets{std::move(targets)}, weights{std::move(weights)} {}
+
+        /// @return Zwraca liczbe wierzcholkow.
+        sizeType sizeV() const
+            { return offsets.size() - 1; }
+
+        /// @return Zwraca liczbe wpisow w tablicy sasiadow (dwukrotnosc liczby krawedzi nieskierowanych).
+        sizeType sizeE() const
+            { return targets.size(); }
+
+        /// @param v indeks wierzcholka
+        /// @return Zwraca stopien wierzcholka.
+        sizeType degree(const sizeType& v) const
+            { return offsets[v + 1] - offsets[v]; }
+
+        /// @param v indeks wierzcholka (dopuszczalne v == sizeV())
+        /// @return Zwraca indeks pierwszego sasiada wierzcholka w tablicach celow i wag.
+        sizeType offset(const sizeType& v) const
+            { return offsets[v]; }
+
+        /// @param k indeks wpisu w tablicy sasiadow
+        /// @return Zwraca indeks wierzcholka sasiedniego.
+        std::uint32_t target(const sizeType& k) const
+            { return targets[k]; }
+
+        /// @param k indeks wpisu w tablicy sasiadow
+        /// @return Zwraca wage krawedzi.
+        const W& weight(const sizeType& k) const
+            { return weights[k]; }
+
+        /// @return Zwraca widok tablic migawki, wazny do zniszczenia lub przypisania migawki.
+        CSRView<W> view() const
+            { return CSRView<W>(sizeV(), offsets.data(), targets.data(), weights.data()); }
+
+        /// @brief Niejawna konwersja pozwalajaca przekazac migawke do algorytmow przyjmujacych widok.
+        operator CSRView<W>() const
+            { return view(); }
+
+    private:
+        std::vector<sizeType> offsets;
+        std::vector<std::uint32_t> targets;
+        std::vector<W> weights;
+};
+
+/// @brief Budowniczy migawki CSR z listy krawedzi nieskierowanych w dowolnej kolejnosci.
+/// Krawedzie sa rozkladane do tablic sasiadow sortowaniem przez zliczanie (dwa przejscia: stopnie, potem
+/// rozmieszczenie), wiec budowa dziala w czasie O(V + E) bez pojedynczych alokacji na krawedz.
+/// @tparam W typ danych na krawedziach grafu
+template <typename W>
+class CSRBuilder
+{
+    public:
+        /// @brief Krawedz nieskierowana u-v o wadze w.
+        struct Arc
+        {
+            std::uint32_t u;
+            std::uint32_t v;
+            W w;
+        };
+
+        /// @brief Konstruktor budowniczego.
+        /// @param vertices poczatkowa liczba wierzcholkow (zwiekszana przez krawedzie o wiekszych indeksach)
+        CSRBuilder(const sizeType& vertices = 0): vertices{vertices} {}
+
+        /// @return Zwraca liczbe wierzcholkow budowanego grafu.
+        sizeType sizeV() const
+            { return vertices; }
+
+        /// @return Zwraca liczbe dodanych krawedzi (przed usunieciem petli i powtorzen).
+        sizeType sizeE() const
+            { return arcs.size(); }
+
+        /// @brief Ustawia liczbe wierzcholkow co najmniej na podana.
+        /// @param count liczba wierzcholkow
+        void resize(const sizeType& count)
+            { vertices = std::max(vertices, count); }
+
+        /// @brief Rezerwuje pamiec na podana liczbe krawedzi.
+        /// @param count liczba krawedzi
+        void reserve(const sizeType& count)
+            { arcs.reserve(count); }
+
+        /// @brief Dodaje krawedz nieskierowana.
+        /// @param u indeks pierwszego wierzcholka
+        /// @param v indeks drugiego wierzcholka
+        /// @param w waga krawedzi
+        void addEdge(const std::uint32_t& u, const std::uint32_t& v, const W& w)
+        {
+            arcs.push_back({ u, v, w });
+            vertices = std::max<sizeType>(vertices, std::max(u, v) + sizeType(1));
+        }
+
+        /// @brief Dodaje krawedzie z podanej tablicy.
+        /// @param edges krawedzie do dodania
+        void append(const std::vector<Arc>& edges)
+        {
+            for (auto & e : edges)
+                vertices = std::max<sizeType>(vertices, std::max(e.u, e.v) + sizeType(1));
+            arcs.insert(arcs.end(), edges.begin(), edges.end());
+        }
+
+        /// @brief Buduje migawke i zwalnia zgromadzone krawedzie.
+        /// @param simple usuniecie petli i krawedzi wielokrotnych (z powtorzen zostaje krawedz o najmniejszej wadze)
+        /// @return Zwraca migawke grafu; kazda krawedz zapisana jest raz dla kazdego wierzcholka koncowego.
+        CSRGraph<W> build(const bool& simple = true)
+        {
+            TRACE_SPAN("CSRBuilder::build");
+            std::vector<sizeType> offsets(vertices + 1, 0);
+            for (auto & e : arcs)
+            {
+                if (simple && e.u == e.v)
+                    continue;
+                offsets[e.u + 1]++;
+                offsets[e.v + 1]++;
+            }
+            for (sizeType v = 0; v < vertices; v++)
+                offsets[v + 1] += offsets[v];
+
+            std::vector<std::uint32_t> targets(offsets[vertices]);
+            std::vector<W> weights(offsets[vertices]);
+            std::vector<sizeType> next(offsets.begin(), offsets.end() - 1);
+            for (auto & e : arcs)
+            {
+                if (simple && e.u == e.v)
+                    continue;
+                targets[next[e.u]] = e.v;
+                weights[next[e.u]++] = e.w;
+                targets[next[e.v]] = e.u;
+                weights[next[e.v]++] = e.w;
+            }
+            std::vector<Arc>().swap(arcs);
+
+            if (simple)
+                removeDuplicates(offsets, targets, weights);
+            return CSRGraph<W>(std::move(offsets), std::move(targets), std::move(weights));
+        }
+
+        /// @brief Sortuje sasiadow kazdego wierzcholka i pozostawia jeden wpis na sasiada, o najmniejszej wadze.
+        /// Tablice sa zageszczane w miejscu, bo nowe polozenie wpisu nigdy nie wyprzedza starego.
+        /// @param offsets poczatki list sasiadow (liczba wierzcholkow + 1 elementow)
+        /// @param targets sasiedzi kolejnych wierzcholkow
+        /// @param weights wagi krawedzi do sasiadow
+        static void removeDuplicates(std::vector<sizeType>& offsets, std::vector<std::uint32_t>& targets, std::vector<W>& weights)
+        {
+            std::vector<std::pair<std::uint32_t, W>> adjacency;
+            sizeType write = 0;
+            for (sizeType v = 0; v + 1 < offsets.size(); v++)
+            {
+                const sizeType begin = offsets[v];
+                const sizeType end = offsets[v + 1];
+                adjacency.clear();
+                for (sizeType k = begin; k < end; k++)
+                    adjacency.emplace_back(targets[k], weights[k]);
+                std::sort(adjacency.begin(), adjacency.end(), [](const std::pair<std::uint32_t, W>& a, const std::pair<std::uint32_t, W>& b)
+                    { return a.first < b.first || (a.first == b.first && a.second < b.second); });
+
+                offsets[v] = write;
+                for (sizeType k = 0; k < adjacency.size(); k++)
+                {
+                    if (k > 0 && adjacency[k].first == adjacency[k - 1].first)
+                        continue;
+                    targets[write] = adjacency[k].first;
+                    weights[write++] = adjacency[k].second;
+                }
+            }
+            offsets.back() = write;
+            targets.resize(write);
+            weights.resize(write);
+            targets.shrink_to_fit();
+            weights.shrink_to_fit();
+        }
+
+    private:
+        sizeType vertices;
+        std::vector<Arc> arcs;
+};
+
+#endif
@@ -0,0 +1,235 @@
+#ifndef DELTA_STEPPING_HPP
+#define DELTA_STEPPING_HPP
+
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <climits>
+#include <cstdint>
+
+#include "graph.hpp"
+#include "csr_graph.hpp"
+#include "thread_pool.hpp"
+#include "trace.hpp"
+
+/// @brief Rownolegly algorytm najkrotszych sciezek z jednego zrodla delta-stepping (Meyer, Sanders).
+/// Wierzcholki grupowane sa w kubelki szerokosci delta wedlug odleglosci. Krawedzie lekkie (waga <= delta)
+/// relaksowane sa wielokrotnie az do oproznienia biezacego kubelka, a ciezkie raz, dla wszystkich
+/// wierzcholkow zdjetych z kubelka. Relaksacje w fazie wykonywane sa rownolegle, a odleglosci
+/// zmniejszane operacja atomowego minimum (compare-exchange). Wyniki sa identyczne z DijkstraAlgorithm.
+/// Obsluguje tylko wagi int: odleglosci przechowywane sa w tablicy std::atomic<int>.
+class DeltaSteppingAlgorithm
+{
+    public:
+        /// @brief Najwieksza liczba kubelkow w pierscieniu. Zbyt male delta jest zwiekszane do maxWaga / maxBuckets.
+        static constexpr sizeType maxBuckets = 1 << 16;
+
+        /// @brief Fazy z mniejsza liczba wierzcholkow wykonywane sa na watku wywolujacym, bez budzenia puli.
+        static constexpr sizeType sequentialFrontier = 256;
+
+        /// @brief Konstruktor tworzacy wlasna pule watkow.
+        /// @param threads liczba watkow (0 - liczba rdzeni)
+        /// @param pin przypiecie watkow do kolejnych rdzeni (tylko Linux)
+        DeltaSteppingAlgorithm(const sizeType& threads = 0, const bool& pin = false):
+            ownedPool{new ThreadPool(threads, pin)}, pool{ownedPool.get()} {}
+
+        /// @brief Konstruktor korzystajacy z istniejacej puli watkow.
+        /// @param pool pula watkow, ktora musi istniec dluzej niz ten obiekt
+        DeltaSteppingAlgorithm(ThreadPool& pool): pool{&pool} {}
+
+        /// @brief Wyznacza szerokosc kubelka jako maksymalna wage podzielona przez sredni stopien wierzcholka.
+        /// @param graph widok grafu w formacie CSR (CSRGraph, MappedGraph albo CSRView)
+        /// @return Zwraca szerokosc kubelka (co najmniej 1).
+        static int autoDelta(const CSRView<int>& graph)
+            { return autoDelta(graph, maxWeight(graph)); }
+
+        /// @brief Algorytm delta-stepping dla grafu w formacie CSR.
+        /// @param graph widok grafu w formacie CSR (CSRGraph, MappedGraph albo CSRView) z nieujemnymi wagami krawedzi
+        /// @param v indeks wierzcholka wejsciowego
+        /// @param delta szerokosc kubelka (0 - dobierana automatycznie)
+        /// @return Zwraca std::vector<int> zawierajacy dlugosci sciezek do kazdego wektora w grafie.
+        std::vector<int> shortestPath(const CSRView<int>& graph, const sizeType& v, int delta = 0)
+        {
+            TRACE_SPAN("DeltaSteppingAlgorithm::shortestPath");
+            const sizeType n = graph.sizeV();
+            const int heaviest = maxWeight(graph);
+            if (delta <= 0)
+                delta = autoDelta(graph, heaviest);
+            if (delta < heaviest / static_cast<int>(maxBuckets) + 1)
+                delta = heaviest / static_cast<int>(maxBuckets) + 1;
+
+            // Relaksacja z kubelka b trafia do kubelkow b..b + heaviest / delta + 1, wiec tyle kubelkow wystarcza w pierscieniu
+            const sizeType ring = heaviest / delta + 2;
+            rings.resize(pool->size());
+            for (auto & r : rings)
+            {
+                for (auto & slot : r)
+                    slot.clear();
+                r.resize(ring);
+            }
+
+            std::vector<std::atomic<int>> D(n);
+            for (auto & d : D)
+                d.store(INT_MAX, std::memory_order_relaxed);
+            marks.assign(n, 0);
+
+            D[v].store(0, std::memory_order_relaxed);
+            rings[0][0].push_back(static_cast<std::uint32_t>(v));
+
+            Phase phase{ graph, D, delta, ring };
+            std::vector<std::uint32_t> frontier;
+            std::vector<std::uint32_t> removed;
+            sizeType b = 0;
+            while (nextBucket(b))
+            {
+                removed.clear();
+                while (gather(D, b, delta, frontier))
+                {
+                    for (auto & u : frontier)
+                        if (!(marks[u] & REMOVED))
+                        {
+                            marks[u] |= REMOVED;
+                            removed.push_back(u);
+                        }
+                    relax(phase, frontier, true);
+                    for (auto & u : frontier)
+                        marks[u] &= ~QUEUED;
+                }
+                relax(phase, removed, false);
+                ++b;
+            }
+
+            std::vector<int> out(n);
+            for (sizeType i = 0; i < n; i++)
+                out[i] = D[i].load(std::memory_order_relaxed);
+            return out;
+        }
+
+        /// @brief Algorytm delta-stepping. Graf zamieniany jest najpierw na migawke CSR (koszt O(V + E));
+        /// przy wielu zapytaniach na tym samym grafie lepiej wywolac freeze() raz i uzyc wersji dla CSR.
+        /// @tparam T typ elementow na wierzcholkach
+        /// @param graph referencja do nieskierowanego grafu prostego z nieujemnymi wagami krawedzi
+        /// @param v referencja do wierzcholka wejsciowego
+        /// @param delta szerokosc kubelka (0 - dobierana automatycznie)
+        /// @return Zwraca std::vector<int> zawierajacy dlugosci sciezek do kazdego wektora w grafie.
+        template <typename T>
+        std::vector<int> shortestPath(const GraphADT<T,int>* graph, const Vertex<T,int>* v, const int& delta = 0)
+            { return shortestPath(graph->freeze(), v->i, delta); }
+
+    private:
+        /// @brief Parametry biezacego zapytania, wspolne dla wszystkich faz.
+        struct Phase
+        {
+            const CSRView<int> graph;
+            std::vector<std::atomic<int>>& D;
+            const int delta;
+            const sizeType ring;
+        };
+
+        // Znaczniki wierzcholkow: dodany do biezacej fazy, zdjety z biezacego kubelka
+        static constexpr char QUEUED = 1;
+        static constexpr char REMOVED = 2;
+
+        static int maxWeight(const CSRView<int>& graph)
+        {
+            int heaviest = 0;
+            for (sizeType k = 0; k < graph.sizeE(); k++)
+                if (graph.weight(k) > heaviest)
+                    heaviest = graph.weight(k);
+            return heaviest;
+        }
+
+        static int autoDelta(const CSRView<int>& graph, const int& heaviest)
+        {
+            const sizeType degree = graph.sizeV() ? graph.sizeE() / graph.sizeV() : 0;
+            const int delta = degree > 1 ? static_cast<int>(heaviest / degree) : heaviest;
+            return delta > 0 ? delta : 1;
+        }
+
+        /// @brief Przesuwa b na pierwszy niepusty kubelek, zaczynajac od b.
+        /// @return Zwraca falsz, jezeli wszystkie kubelki sa puste.
+        bool nextBucket(sizeType& b) const
+        {
+            const sizeType ring = rings.front().size();
+            for (sizeType step = 0; step < ring; step++)
+                for (auto & r : rings)
+                    if (!r[(b + step) % ring].empty())
+                    {
+                        b += step;
+                        return true;
+                    }
+            return false;
+        }
+
+        /// @brief Przenosi zawartosc kubelka b wszystkich watkow do frontier, pomijajac wpisy przestarzale
+        /// (wierzcholki, ktorych odleglosc spadla ponizej kubelka) i powtorzenia.
+        /// @return Zwraca falsz, jezeli kubelek byl pusty.
+        bool gather(const std::vector<std::atomic<int>>& D, const sizeType& b, const int& delta, std::vector<std::uint32_t>& frontier)
+        {
+            frontier.clear();
+            const sizeType ring = rings.front().size();
+            for (auto & r : rings)
+            {
+                std::vector<std::uint32_t>& slot = r[b % ring];
+                for (auto & u : slot)
+                    if (!(marks[u] & QUEUED) && static_cast<sizeType>(D[u].load(std::memory_order_relaxed) / delta) == b)
+                    {
+                        marks[u] |= QUEUED;
+                        frontier.push_back(u);
+                    }
+                slot.clear();
+            }
+            return !frontier.empty();
+        }
+
+        /// @brief Relaksuje krawedzie lekkie albo ciezkie wszystkich wierzcholkow z listy.
+        void relax(const Phase& phase, const std::vector<std::uint32_t>& list, const bool& light)
+        {
+            if (list.empty())
+                return;
+
+            const sizeType chunks = list.size() < sequentialFrontier || pool->size() == 1 ? 1 : 8 * pool->size();
+            auto body = [&](sizeType worker, sizeType chunk)
+            {
+                std::vector<std::vector<std::uint32_t>>& own = rings[worker];
+                const sizeType first = list.size() * chunk / chunks;
+                const sizeType last = list.size() * (chunk + 1) / chunks;
+                for (sizeType i = first; i < last; i++)
+                {
+                    const std::uint32_t u = list[i];
+                    const std::int64_t du = phase.D[u].load(std::memory_order_relaxed);
+                    for (sizeType k = phase.graph.offset(u); k < phase.graph.offset(u + 1); k++)
+                    {
+                        const int w = phase.graph.weight(k);
+                        if ((w <= phase.delta) != light)
+                            continue;
+
+                        // Suma liczona na 64 bitach; wynik mniejszy od aktualnej odleglosci miesci sie w int
+                        const std::int64_t candidate = du + w;
+                        std::atomic<int>& dz = phase.D[phase.graph.target(k)];
+                        int current = dz.load(std::memory_order_relaxed);
+                        while (candidate < current)
+                            if (dz.compare_exchange_weak(current, static_cast<int>(candidate), std::memory_order_relaxed))
+                            {
+                                own[(candidate / phase.delta) % phase.ring].push_back(phase.graph.target(k));
+                                break;
+                            }
+                    }
+                }
+            };
+
+            if (chunks == 1)
+                body(0, 0);
+            else
+                pool->parallelFor(chunks, body);
+        }
+
+        std::unique_ptr<ThreadPool> ownedPool;
+        ThreadPool* pool;
+
+        // Pierscienie kubelkow kazdego watku; watek dopisuje wierzcholki tylko do wlasnego pierscienia
+        std::vector<std::vector<std::vector<std::uint32_t>>> rings;
+        std::vector<char> marks;
+};
+
+#endif
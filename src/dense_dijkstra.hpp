@@ -0,0 +1,340 @@
+#ifndef DENSE_DIJKSTRA_HPP
+#define DENSE_DIJKSTRA_HPP
+
+#include <vector>
+#include <string>
+#include <climits>
+
+// Jadra SIMD kompilowane sa dla x86 niezaleznie od flag kompilatora, a wybierane w czasie wykonania
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define DENSE_DIJKSTRA_SIMD
+#define DENSE_DIJKSTRA_TARGET(isa) __attribute__((target(isa)))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h>
+#include <intrin.h>
+#define DENSE_DIJKSTRA_SIMD
+#define DENSE_DIJKSTRA_TARGET(isa)
+#endif
+
+#include "graph.hpp"
+
+/// @brief Tablicowa wersja algorytmu Dijkstry o zlozonosci O(V^2) dla grafow gestych.
+/// Zamiast kopca w kazdym kroku wyszukiwane jest minimum w plaskiej tablicy kluczy, a nastepnie
+/// relaksowany jest caly wiersz wag. Obie petle maja wersje AVX2, SSE4.1 i skalarna; wersja wybierana jest
+/// raz, przy pierwszym wywolaniu, na podstawie instrukcji obslugiwanych przez procesor.
+class DenseDijkstraAlgorithm
+{
+    public:
+        DenseDijkstraAlgorithm() = delete;
+
+        /// @return Zwraca nazwe wersji jader wybranej dla biezacego procesora ("avx2", "sse4.1" albo "scalar").
+        static const char* simdPath()
+            { return kernels().name; }
+
+        /// @brief Wymusza wersje jader zamiast wybranej automatycznie, np. aby porownac je ze soba.
+        /// Nie moze byc wywolywana w trakcie obliczen prowadzonych przez inne watki.
+        /// @param name nazwa wersji ("avx2", "sse4.1" albo "scalar")
+        /// @return Zwraca falsz, jezeli procesor nie obsluguje danej wersji; wybor pozostaje wtedy bez zmian.
+        static bool forceSimdPath(const std::string& name)
+        {
+            if (name == "scalar")
+                kernels() = Kernels{ relaxRowScalar, minIndexScalar, "scalar" };
+#if defined(DENSE_DIJKSTRA_SIMD)
+            else if (name == "avx2" && supports(AVX2))
+                kernels() = Kernels{ relaxRowAvx2, minIndexAvx2, "avx2" };
+            else if (name == "sse4.1" && supports(SSE41))
+                kernels() = Kernels{ relaxRowSse41, minIndexSse41, "sse4.1" };
+#endif
+            else
+                return false;
+            return true;
+        }
+
+        /// Gestosc grafu, od ktorej wersja tablicowa jest wybierana automatycznie.
+        static constexpr double densityThreshold = 0.5;
+
+        /// @brief Algorytm Dijkstry O(V^2) dla dowolnej implementacji grafu. Wiersz wag wierzcholka
+        /// zdejmowanego z kolejki budowany jest w buforze roboczym na podstawie krawedzi incydentnych.
+        /// @tparam T typ elementow na wierzcholkach
+        /// @param graph referencja do nieskierowanego grafu prostego z nieujemnymi wagami krawedzi
+        /// @param v referencja do wierzcholka wejsciowego
+        /// @return Zwraca std::vector<int> zawierajacy dlugosci sciezek do kazdego wektora w grafie.
+        template <typename T>
+        static std::vector<int> shortestPath(const GraphADT<T,int>* graph, const Vertex<T,int>* v)
+        {
+            TRACE_SPAN("DenseDijkstraAlgorithm::shortestPath");
+            const Kernels& simd = kernels();
+            const sizeType n = graph->sizeV();
+            std::vector<int> D(n, INT_MAX);
+            std::vector<int> K(n, INT_MAX);
+            std::vector<int> S(n, 0);
+            std::vector<int> row(n, INT_MAX);
+            K[v->i] = 0;
+
+            for (sizeType step = 0; step < n; step++)
+            {
+                int du;
+                const sizeType u = simd.minIndex(K.data(), n, du);
+                if (u == n)
+                    break;
+                settle(u, du, D.data(), K.data(), S.data());
+
+                const Vertex<T,int>* vu = graph->vertex(u);
+                for (auto e : graph->incidentEdgesRange(vu))
+                    row[graph->opposite(vu, e)->i] = e->element;
+                simd.relaxRow(du, row.data(), K.data(), S.data(), n);
+                for (auto e : graph->incidentEdgesRange(vu))
+                    row[graph->opposite(vu, e)->i] = INT_MAX;
+            }
+
+            return D;
+        }
+
+        /// @brief Algorytm Dijkstry O(V^2) dla plaskiej macierzy wag.
+        /// @param weights macierz wag n x n w porzadku wierszowym, INT_MAX oznacza brak krawedzi
+        /// @param n liczba wierzcholkow
+        /// @param v indeks wierzcholka wejsciowego
+        /// @return Zwraca std::vector<int> zawierajacy dlugosci sciezek do kazdego wektora w grafie.
+        static std::vector<int> shortestPath(const int* weights, const sizeType& n, const sizeType& v)
+        {
+            TRACE_SPAN("DenseDijkstraAlgorithm::shortestPath(matrix)");
+            const Kernels& simd = kernels();
+            std::vector<int> D(n, INT_MAX);
+            std::vector<int> K(n, INT_MAX);
+            std::vector<int> S(n, 0);
+            K[v] = 0;
+
+            for (sizeType step = 0; step < n; step++)
+            {
+                int du;
+                const sizeType u = simd.minIndex(K.data(), n, du);
+                if (u == n)
+                    break;
+                settle(u, du, D.data(), K.data(), S.data());
+                simd.relaxRow(du, weights + u * n, K.data(), S.data(), n);
+            }
+
+            return D;
+        }
+
+        /// @param graph referencja do grafu
+        /// @return Zwraca prawde, jezeli dla grafu nalezy wybrac wersje tablicowa algorytmu.
+        template <typename T>
+        static bool preferred(const GraphADT<T,int>* graph)
+        {
+            const double n = static_cast<double>(graph->sizeV());
+            if (graph->denseStorage())
+                return true;
+            return n > 1 && 2.0 * graph->sizeE() / (n * (n - 1)) >= densityThreshold;
+        }
+
+    private:
+        /// @brief Zatwierdza odleglosc wierzcholka i wyklucza go z dalszego wyszukiwania minimum.
+        static void settle(const sizeType& u, const int& du, int* D, int* K, int* S)
+        {
+            D[u] = du;
+            K[u] = INT_MAX;
+            S[u] = INT_MAX;
+        }
+
+        /// @brief Wersje jader wybrane dla biezacego procesora.
+        struct Kernels
+        {
+            void (*relaxRow)(const int, const int*, int*, const int*, const sizeType);
+            sizeType (*minIndex)(const int*, const sizeType, int&);
+            const char* name;
+        };
+
+        /// @return Zwraca jadra wybrane przy pierwszym wywolaniu albo wymuszone przez forceSimdPath.
+        static Kernels& kernels()
+        {
+            static Kernels selected = select();
+            return selected;
+        }
+
+        static Kernels select()
+        {
+#if defined(DENSE_DIJKSTRA_SIMD)
+            if (supports(AVX2))
+                return Kernels{ relaxRowAvx2, minIndexAvx2, "avx2" };
+            if (supports(SSE41))
+                return Kernels{ relaxRowSse41, minIndexSse41, "sse4.1" };
+#endif
+            return Kernels{ relaxRowScalar, minIndexScalar, "scalar" };
+        }
+
+#if defined(DENSE_DIJKSTRA_SIMD)
+        enum Extension { SSE41, AVX2 };
+
+        /// @return Zwraca prawde, jezeli procesor i system operacyjny obsluguja dane rozszerzenie.
+        static bool supports(const Extension& extension)
+        {
+#if defined(_MSC_VER) && !defined(__clang__)
+            int info[4];
+            __cpuid(info, 0);
+            const int leaves = info[0];
+            __cpuid(info, 1);
+            if (extension == SSE41)
+                return (info[2] & (1 << 19)) != 0;
+            // AVX2 wymaga rowniez zapisu rejestrow YMM przez system (OSXSAVE i XCR0)
+            if (leaves < 7 || !(info[2] & (1 << 27)) || (_xgetbv(0) & 6) != 6)
+                return false;
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            __builtin_cpu_init();
+            return extension == AVX2 ? __builtin_cpu_supports("avx2") : __builtin_cpu_supports("sse4.1");
+#endif
+        }
+#endif
+
+        /// @brief Relaksuje wszystkie krawedzie wiersza: K[j] = min(K[j], du + row[j]) dla niezatwierdzonych j.
+        /// Suma przekraczajaca INT_MAX traktowana jest jako brak krawedzi, a S[j] == INT_MAX blokuje
+        /// aktualizacje zatwierdzonych wierzcholkow.
+        /// @param du odleglosc zatwierdzanego wierzcholka
+        /// @param row wiersz wag, INT_MAX oznacza brak krawedzi
+        /// @param K klucze niezatwierdzonych wierzcholkow
+        /// @param S maska zatwierdzonych wierzcholkow (0 albo INT_MAX)
+        /// @param n liczba wierzcholkow
+        static void relaxRowScalar(const int du, const int* row, int* K, const int* S, const sizeType n)
+            { relaxTail(du, row, K, S, 0, n); }
+
+        /// @brief Relaksacja elementow [j, n) wiersza w wersji skalarnej.
+        static void relaxTail(const int du, const int* row, int* K, const int* S, sizeType j, const sizeType n)
+        {
+            for (; j < n; j++)
+            {
+                int candidate = row[j] > INT_MAX - du ? INT_MAX : du + row[j];
+                if (candidate < S[j])
+                    candidate = S[j];
+                if (candidate < K[j])
+                    K[j] = candidate;
+            }
+        }
+
+        /// @brief Wyszukuje pierwszy wierzcholek o najmniejszym kluczu.
+        /// @param K klucze niezatwierdzonych wierzcholkow
+        /// @param n liczba wierzcholkow
+        /// @param minimum zwracana wartosc najmniejszego klucza
+        /// @return Zwraca indeks wierzcholka albo n, jezeli wszystkie klucze wynosza INT_MAX.
+        static sizeType minIndexScalar(const int* K, const sizeType n, int& minimum)
+        {
+            minimum = INT_MAX;
+            for (sizeType j = 0; j < n; j++)
+                if (K[j] < minimum)
+                    minimum = K[j];
+            return firstIndex(K, 0, n, minimum);
+        }
+
+        /// @return Zwraca pierwszy indeks od j, pod ktorym znajduje sie minimum, albo n dla minimum == INT_MAX.
+        static sizeType firstIndex(const int* K, sizeType j, const sizeType n, const int minimum)
+        {
+            if (minimum == INT_MAX)
+                return n;
+            while (K[j] != minimum)
+                ++j;
+            return j;
+        }
+
+#if defined(DENSE_DIJKSTRA_SIMD)
+        /// @brief Relaksacja wiersza instrukcjami AVX2 (8 kluczy naraz).
+        DENSE_DIJKSTRA_TARGET("avx2")
+        static void relaxRowAvx2(const int du, const int* row, int* K, const int* S, const sizeType n)
+        {
+            sizeType j = 0;
+            const __m256i limit = _mm256_set1_epi32(INT_MAX - du);
+            const __m256i dist = _mm256_set1_epi32(du);
+            const __m256i infinity = _mm256_set1_epi32(INT_MAX);
+            for (; j + 8 <= n; j += 8)
+            {
+                __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + j));
+                __m256i overflow = _mm256_cmpgt_epi32(w, limit);
+                __m256i candidate = _mm256_blendv_epi8(_mm256_add_epi32(dist, w), infinity, overflow);
+                candidate = _mm256_max_epi32(candidate, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(S + j)));
+                __m256i k = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(K + j));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(K + j), _mm256_min_epi32(k, candidate));
+            }
+            relaxTail(du, row, K, S, j, n);
+        }
+
+        /// @brief Wyszukiwanie minimum instrukcjami AVX2.
+        DENSE_DIJKSTRA_TARGET("avx2")
+        static sizeType minIndexAvx2(const int* K, const sizeType n, int& minimum)
+        {
+            sizeType j = 0;
+            __m256i m = _mm256_set1_epi32(INT_MAX);
+            for (; j + 8 <= n; j += 8)
+                m = _mm256_min_epi32(m, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(K + j)));
+            __m128i x = _mm_min_epi32(_mm256_castsi256_si128(m), _mm256_extracti128_si256(m, 1));
+            x = _mm_min_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
+            x = _mm_min_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)));
+            minimum = _mm_cvtsi128_si32(x);
+            for (; j < n; j++)
+                if (K[j] < minimum)
+                    minimum = K[j];
+            if (minimum == INT_MAX)
+                return n;
+
+            j = 0;
+            const __m256i target = _mm256_set1_epi32(minimum);
+            for (; j + 8 <= n; j += 8)
+            {
+                __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(K + j)), target);
+                if (_mm256_movemask_epi8(eq))
+                    break;
+            }
+            return firstIndex(K, j, n, minimum);
+        }
+
+        /// @brief Relaksacja wiersza instrukcjami SSE4.1 (4 klucze naraz).
+        DENSE_DIJKSTRA_TARGET("sse4.1")
+        static void relaxRowSse41(const int du, const int* row, int* K, const int* S, const sizeType n)
+        {
+            sizeType j = 0;
+            const __m128i limit = _mm_set1_epi32(INT_MAX - du);
+            const __m128i dist = _mm_set1_epi32(du);
+            const __m128i infinity = _mm_set1_epi32(INT_MAX);
+            for (; j + 4 <= n; j += 4)
+            {
+                __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + j));
+                __m128i overflow = _mm_cmpgt_epi32(w, limit);
+                __m128i candidate = _mm_blendv_epi8(_mm_add_epi32(dist, w), infinity, overflow);
+                candidate = _mm_max_epi32(candidate, _mm_loadu_si128(reinterpret_cast<const __m128i*>(S + j)));
+                __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(K + j));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(K + j), _mm_min_epi32(k, candidate));
+            }
+            relaxTail(du, row, K, S, j, n);
+        }
+
+        /// @brief Wyszukiwanie minimum instrukcjami SSE4.1.
+        DENSE_DIJKSTRA_TARGET("sse4.1")
+        static sizeType minIndexSse41(const int* K, const sizeType n, int& minimum)
+        {
+            sizeType j = 0;
+            __m128i x = _mm_set1_epi32(INT_MAX);
+            for (; j + 4 <= n; j += 4)
+                x = _mm_min_epi32(x, _mm_loadu_si128(reinterpret_cast<const __m128i*>(K + j)));
+            x = _mm_min_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
+            x = _mm_min_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)));
+            minimum = _mm_cvtsi128_si32(x);
+            for (; j < n; j++)
+                if (K[j] < minimum)
+                    minimum = K[j];
+            if (minimum == INT_MAX)
+                return n;
+
+            j = 0;
+            const __m128i target = _mm_set1_epi32(minimum);
+            for (; j + 4 <= n; j += 4)
+            {
+                __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(K + j)), target);
+                if (_mm_movemask_epi8(eq))
+                    break;
+            }
+            return firstIndex(K, j, n, minimum);
+        }
+#endif
+};
+
+#endif
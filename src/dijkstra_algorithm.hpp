@@ -2,18 +2,26 @@
 #define DIJKSTRA_ALGORITHM_HPP
 
 #include <vector>
-#include <queue>
-#include <map>
+#include <climits>
+#include <cstdint>
+#include <algorithm>
 
 #include <chrono>
 
 #include "graph.hpp"
+#include "priority_queue.hpp"
+#include "algorithm_stats.hpp"
+#include "shortest_path_tree.hpp"
+#include "dense_dijkstra.hpp"
+#include "weight_traits.hpp"
 
 #ifndef TIME_POINT
 #define TIME_POINT std::chrono::high_resolution_clock::now()
 #endif
 
-/// @brief Klasa implementujaca algorytm Dijkstry
+/// @brief Klasa implementujaca algorytm Dijkstry. Wagi krawedzi moga miec dowolny typ obslugiwany przez WeightTraits
+/// (typy calkowite, float, double, FixedPoint); odleglosci maja ten sam typ, a wierzcholki nieosiagalne otrzymuja
+/// WeightTraits<W>::infinity() (INT_MAX dla int).
 class DijkstraAlgorithm
 {
     public:
@@ -21,14 +29,15 @@ class DijkstraAlgorithm
 
         /// @brief Driver algorytmu Dijkstry. Prezentuje dzialanie algorytmu dla grafu z mala iloscia wierzcholkow.
         /// @tparam T typ elementow na wierzcholkach
+        /// @tparam W typ wag krawedzi
         /// @param graph referencja do nieskierowanego grafu prostego z nieujemnymi wagami krawedzi
         /// @param v referencja do wierzcholka wejsciowego
-        /// @return Zwraca std::vector<int> zawierajacy dlugosci sciezek do kazdego wektora w grafie.
-        template <typename T>
-        static std::vector<int> driver(const GraphADT<T,int>* graph, const Vertex<T,int>* v)
+        /// @return Zwraca std::vector<W> zawierajacy dlugosci sciezek do kazdego wektora w grafie.
+        template <typename T, typename W>
+        static std::vector<W> driver(const GraphADT<T,W>* graph, const Vertex<T,W>* v)
         {
-            std::vector<int> D(graph->sizeV(), INT_MAX);
-            D[v->i] = 0;
+            std::vector<W> D(graph->sizeV(), WeightTraits<W>::infinity());
+            D[v->i] = WeightTraits<W>::zero();
 
             if (graph->sizeV() > 10) return D;
 
@@ -37,26 +46,23 @@ class DijkstraAlgorithm
                 std::cout << static_cast<char>('a' + i) << "=" << D[i] << ' ';
             std::cout << '}' << std::endl;
 
-            auto compare = [D](const Vertex<T,int>* v, const Vertex<T,int>* u) { return D[v->i] > D[u->i]; };
-            
-            std::priority_queue<const Vertex<T,int>*, std::vector<const Vertex<T,int>*>, decltype(compare)> Q(compare);
-            for (auto & i : graph->vertices())
-                Q.push(i);
+            BinaryHeap<W> Q(graph->sizeV());
+            Q.push(v->i, D[v->i]);
 
             int step = 1;
 
             while (!Q.empty())
             {
-                const Vertex<T,int>* u = Q.top();
+                const Vertex<T,W>* u = graph->vertex(Q.top());
                 Q.pop();
 
-                for (auto & i : graph->incidentEdges(u))
+                for (auto i : graph->incidentEdgesRange(u))
                 {
                     auto z = graph->opposite(u, i);
-                    if (D[u->i] + i->element < D[z->i])
+                    if (WeightTraits<W>::improves(D[u->i], i->element, D[z->i]))
                     {
                         D[z->i] = D[u->i] + i->element;
-                        Q.push(u);
+                        Q.pushOrDecrease(z->i, D[z->i]);
                         std::cout << "       " << step++ <<": { ";
                         for (int i = 0; i < D.size(); i++)
                             std::cout << static_cast<char>('a' + i) << "=" << D[i] << ' ';
@@ -69,40 +75,329 @@ class DijkstraAlgorithm
         }
 
         /// @brief Algorytm Dijkstry
+        /// @tparam Q kolejka priorytetowa adresowana indeksem wierzcholka (BinaryHeap, QuaternaryHeap, PairingHeap)
         /// @tparam T typ elementow na wierzcholkach
+        /// @tparam W typ wag krawedzi
         /// @param graph referencja do nieskierowanego grafu prostego z nieujemnymi wagami krawedzi
         /// @param v referencja do wierzcholka wejsciowego
-        /// @return Zwraca std::vector<int> zawierajacy dlugosci sciezek do kazdego wektora w grafie.
-        template <typename T>
-        static std::vector<int> shortestPath(const GraphADT<T,int>* graph, const Vertex<T,int>* v)
+        /// @return Zwraca std::vector<W> zawierajacy dlugosci sciezek do kazdego wektora w grafie.
+        template <template <typename> class Q = BinaryHeap, typename T, typename W>
+        static std::vector<W> shortestPath(const GraphADT<T,W>* graph, const Vertex<T,W>* v)
+        {
+            NoStats stats;
+            return shortestPath<Q>(graph, v, stats);
+        }
+
+        /// @brief Algorytm Dijkstry zliczajacy wykonane operacje.
+        /// @tparam Q kolejka priorytetowa adresowana indeksem wierzcholka (BinaryHeap, QuaternaryHeap, PairingHeap)
+        /// @tparam T typ elementow na wierzcholkach
+        /// @tparam S polityka statystyk (NoStats, CountingStats)
+        /// @tparam W typ wag krawedzi
+        /// @param graph referencja do nieskierowanego grafu prostego z nieujemnymi wagami krawedzi
+        /// @param v referencja do wierzcholka wejsciowego
+        /// @param stats statystyki, do ktorych dopisywane sa operacje algorytmu
+        /// @return Zwraca std::vector<W> zawierajacy dlugosci sciezek do kazdego wektora w grafie.
+        template <template <typename> class Q = BinaryHeap, typename T, typename S, typename W>
+        static std::vector<W> shortestPath(const GraphADT<T,W>* graph, const Vertex<T,W>* v, S& stats)
         {
-            std::vector<int> D(graph->sizeV(), INT_MAX);
-            D[v->i] = 0;
+            std::vector<W> D(graph->sizeV());
+            Q<W> queue(graph->sizeV());
+            shortestPath(graph, v, D.data(), queue, stats);
+            return D;
+        }
 
-            auto compare = [D](const Vertex<T,int>* v, const Vertex<T,int>* u) { return D[v->i] > D[u->i]; };
-            
-            std::priority_queue<const Vertex<T,int>*, std::vector<const Vertex<T,int>*>, decltype(compare)> Q(compare);
-            for (auto & i : graph->vertices())
-                Q.push(i);
+        /// @brief Algorytm Dijkstry wyznaczajacy drzewo najkrotszych sciezek (odleglosci i poprzedniki).
+        /// @tparam Q kolejka priorytetowa adresowana indeksem wierzcholka (BinaryHeap, QuaternaryHeap, PairingHeap)
+        /// @tparam T typ elementow na wierzcholkach
+        /// @tparam W typ wag krawedzi
+        /// @param graph referencja do nieskierowanego grafu prostego z nieujemnymi wagami krawedzi
+        /// @param v referencja do wierzcholka wejsciowego
+        /// @return Zwraca drzewo najkrotszych sciezek, z ktorego sciezki do celow odtwarzane sa na zadanie.
+        template <template <typename> class Q = BinaryHeap, typename T, typename W>
+        static BasicShortestPathTree<W> shortestPathTree(const GraphADT<T,W>* graph, const Vertex<T,W>* v)
+        {
+            NoStats stats;
+            return shortestPathTree<Q>(graph, v, stats);
+        }
 
-            while (!Q.empty())
+        /// @brief Algorytm Dijkstry wyznaczajacy drzewo najkrotszych sciezek, zliczajacy wykonane operacje.
+        /// @tparam Q kolejka priorytetowa adresowana indeksem wierzcholka (BinaryHeap, QuaternaryHeap, PairingHeap)
+        /// @tparam T typ elementow na wierzcholkach
+        /// @tparam S polityka statystyk (NoStats, CountingStats)
+        /// @tparam W typ wag krawedzi
+        /// @param graph referencja do nieskierowanego grafu prostego z nieujemnymi wagami krawedzi
+        /// @param v referencja do wierzcholka wejsciowego
+        /// @param stats statystyki, do ktorych dopisywane sa operacje algorytmu
+        /// @return Zwraca drzewo najkrotszych sciezek, z ktorego sciezki do celow odtwarzane sa na zadanie.
+        template <template <typename> class Q = BinaryHeap, typename T, typename S, typename W>
+        static BasicShortestPathTree<W> shortestPathTree(const GraphADT<T,W>* graph, const Vertex<T,W>* v, S& stats)
+        {
+            std::vector<W> D(graph->sizeV());
+            std::vector<std::uint32_t> P(graph->sizeV());
+            Q<W> queue(graph->sizeV());
+            shortestPath<true>(graph, v, D.data(), P.data(), queue, stats);
+            return BasicShortestPathTree<W>(v->i, std::move(D), std::move(P));
+        }
+
+        /// @brief Algorytm Dijkstry korzystajacy z pamieci wywolujacego, bez alokacji. Pozwala wielokrotnie
+        /// uzywac tej samej kolejki i zapisywac wynik bezposrednio do wiersza macierzy odleglosci.
+        /// @tparam T typ elementow na wierzcholkach
+        /// @tparam W typ wag krawedzi
+        /// @tparam Queue kolejka priorytetowa adresowana indeksem wierzcholka, z kluczami typu W
+        /// @tparam S polityka statystyk (NoStats, CountingStats)
+        /// @param graph referencja do nieskierowanego grafu prostego z nieujemnymi wagami krawedzi
+        /// @param v referencja do wierzcholka wejsciowego
+        /// @param D tablica sizeV() elementow, w ktorej zapisywane sa dlugosci sciezek
+        /// @param queue pusta kolejka o pojemnosci co najmniej sizeV(); po zakonczeniu jest znowu pusta
+        /// @param stats statystyki, do ktorych dopisywane sa operacje algorytmu
+        template <typename T, typename W, typename Queue, typename S>
+        static void shortestPath(const GraphADT<T,W>* graph, const Vertex<T,W>* v, W* D, Queue& queue, S& stats)
+            { shortestPath<false>(graph, v, D, nullptr, queue, stats); }
+
+        /// @brief Algorytm Dijkstry korzystajacy z pamieci wywolujacego, z opcjonalnym zapisem poprzednikow.
+        /// @tparam Predecessors zapis poprzednikow do tablicy P; dla false tablica nie jest uzywana, a petla
+        /// relaksacji jest identyczna jak bez drzewa
+        /// @tparam T typ elementow na wierzcholkach
+        /// @tparam W typ wag krawedzi
+        /// @tparam Queue kolejka priorytetowa adresowana indeksem wierzcholka, z kluczami typu W
+        /// @tparam S polityka statystyk (NoStats, CountingStats)
+        /// @param graph referencja do nieskierowanego grafu prostego z nieujemnymi wagami krawedzi
+        /// @param v referencja do wierzcholka wejsciowego
+        /// @param D tablica sizeV() elementow, w ktorej zapisywane sa dlugosci sciezek
+        /// @param P tablica sizeV() elementow, w ktorej zapisywane sa poprzedniki (ShortestPathTree::NONE dla zrodla
+        /// i wierzcholkow nieosiagalnych), albo nullptr dla Predecessors == false
+        /// @param queue pusta kolejka o pojemnosci co najmniej sizeV(); po zakonczeniu jest znowu pusta
+        /// @param stats statystyki, do ktorych dopisywane sa operacje algorytmu
+        template <bool Predecessors, typename T, typename W, typename Queue, typename S>
+        static void shortestPath(const GraphADT<T,W>* graph, const Vertex<T,W>* v, W* D, std::uint32_t* P, Queue& queue, S& stats)
+        {
+            TRACE_SPAN("DijkstraAlgorithm::shortestPath");
+            std::fill(D, D + graph->sizeV(), WeightTraits<W>::infinity());
+            if constexpr (Predecessors)
+                std::fill(P, P + graph->sizeV(), ShortestPathTree::NONE);
+            D[v->i] = WeightTraits<W>::zero();
+
+            queue.push(v->i, D[v->i]);
+            stats.push();
+
+            while (!queue.empty())
             {
-                const Vertex<T,int>* u = Q.top();
-                Q.pop();
+                const Vertex<T,W>* u = graph->vertex(queue.top());
+                queue.pop();
+                stats.pop();
 
-                for (auto & i : graph->incidentEdges(u))
+                stats.incidentEdges();
+                for (auto i : graph->incidentEdgesRange(u))
                 {
                     auto z = graph->opposite(u, i);
-                    if (D[u->i] + i->element < D[z->i])
+                    stats.relaxAttempt();
+                    // Warunek nie dopuszcza przepelnienia D[u] + waga (dla int zapisany jako roznica)
+                    if (WeightTraits<W>::improves(D[u->i], i->element, D[z->i]))
                     {
                         D[z->i] = D[u->i] + i->element;
-                        Q.push(u);
+                        if constexpr (Predecessors)
+                            P[z->i] = static_cast<std::uint32_t>(u->i);
+                        stats.relaxSuccess();
+                        if constexpr (S::enabled)
+                        {
+                            if (queue.contains(z->i))
+                                stats.decreaseKey();
+                            else
+                                stats.push();
+                        }
+                        queue.pushOrDecrease(z->i, D[z->i]);
                     }
                 }
             }
+        }
 
+        /// @brief Algorytm Dijkstry z automatycznym wyborem wariantu. Dla macierzy sasiedztwa oraz grafow o gestosci
+        /// co najmniej DenseDijkstraAlgorithm::densityThreshold uzywana jest wersja tablicowa O(V^2),
+        /// w przeciwnym wypadku wersja z kopcem.
+        /// @tparam T typ elementow na wierzcholkach
+        /// @param graph referencja do nieskierowanego grafu prostego z nieujemnymi wagami krawedzi
+        /// @param v referencja do wierzcholka wejsciowego
+        /// @return Zwraca std::vector<int> zawierajacy dlugosci sciezek do kazdego wektora w grafie.
+        template <typename T>
+        static std::vector<int> shortestPathAuto(const GraphADT<T,int>* graph, const Vertex<T,int>* v)
+        {
+            if (DenseDijkstraAlgorithm::preferred(graph))
+                return DenseDijkstraAlgorithm::shortestPath(graph, v);
+            return shortestPath(graph, v);
+        }
+
+        /// @brief Algorytm Dijkstry dla migawki grafu w formacie CSR.
+        /// @tparam Q kolejka priorytetowa adresowana indeksem wierzcholka (BinaryHeap, QuaternaryHeap, PairingHeap)
+        /// @tparam W typ wag krawedzi
+        /// @param graph widok grafu w formacie CSR (np. CSRGraph::view() albo MappedGraph::view()) z nieujemnymi wagami krawedzi
+        /// @param v indeks wierzcholka wejsciowego
+        /// @return Zwraca std::vector<W> zawierajacy dlugosci sciezek do kazdego wektora w grafie.
+        template <template <typename> class Q = BinaryHeap, typename W>
+        static std::vector<W> shortestPath(const CSRView<W>& graph, const sizeType& v)
+        {
+            NoStats stats;
+            return shortestPath<Q>(graph, v, stats);
+        }
+
+        /// @brief Algorytm Dijkstry dla migawki grafu w formacie CSR.
+        /// @tparam Q kolejka priorytetowa adresowana indeksem wierzcholka (BinaryHeap, QuaternaryHeap, PairingHeap)
+        /// @tparam W typ wag krawedzi
+        /// @param graph graf w formacie CSR z nieujemnymi wagami krawedzi
+        /// @param v indeks wierzcholka wejsciowego
+        /// @return Zwraca std::vector<W> zawierajacy dlugosci sciezek do kazdego wektora w grafie.
+        template <template <typename> class Q = BinaryHeap, typename W>
+        static std::vector<W> shortestPath(const CSRGraph<W>& graph, const sizeType& v)
+            { return shortestPath<Q>(graph.view(), v); }
+
+        /// @brief Algorytm Dijkstry dla migawki grafu w formacie CSR, zliczajacy wykonane operacje.
+        /// @tparam Q kolejka priorytetowa adresowana indeksem wierzcholka (BinaryHeap, QuaternaryHeap, PairingHeap)
+        /// @tparam S polityka statystyk (NoStats, CountingStats)
+        /// @tparam W typ wag krawedzi
+        /// @param graph widok grafu w formacie CSR z nieujemnymi wagami krawedzi
+        /// @param v indeks wierzcholka wejsciowego
+        /// @param stats statystyki, do ktorych dopisywane sa operacje algorytmu
+        /// @return Zwraca std::vector<W> zawierajacy dlugosci sciezek do kazdego wektora w grafie.
+        template <template <typename> class Q = BinaryHeap, typename S, typename W>
+        static std::vector<W> shortestPath(const CSRView<W>& graph, const sizeType& v, S& stats)
+        {
+            std::vector<W> D(graph.sizeV());
+            Q<W> queue(graph.sizeV());
+            shortestPath(graph, v, D.data(), queue, stats);
             return D;
         }
+
+        /// @brief Algorytm Dijkstry dla migawki grafu w formacie CSR, zliczajacy wykonane operacje.
+        /// @tparam Q kolejka priorytetowa adresowana indeksem wierzcholka (BinaryHeap, QuaternaryHeap, PairingHeap)
+        /// @tparam S polityka statystyk (NoStats, CountingStats)
+        /// @tparam W typ wag krawedzi
+        /// @param graph graf w formacie CSR z nieujemnymi wagami krawedzi
+        /// @param v indeks wierzcholka wejsciowego
+        /// @param stats statystyki, do ktorych dopisywane sa operacje algorytmu
+        /// @return Zwraca std::vector<W> zawierajacy dlugosci sciezek do kazdego wektora w grafie.
+        template <template <typename> class Q = BinaryHeap, typename S, typename W>
+        static std::vector<W> shortestPath(const CSRGraph<W>& graph, const sizeType& v, S& stats)
+            { return shortestPath<Q>(graph.view(), v, stats); }
+
+        /// @brief Algorytm Dijkstry wyznaczajacy drzewo najkrotszych sciezek dla migawki grafu w formacie CSR.
+        /// @tparam Q kolejka priorytetowa adresowana indeksem wierzcholka (BinaryHeap, QuaternaryHeap, PairingHeap)
+        /// @tparam W typ wag krawedzi
+        /// @param graph widok grafu w formacie CSR z nieujemnymi wagami krawedzi
+        /// @param v indeks wierzcholka wejsciowego
+        /// @return Zwraca drzewo najkrotszych sciezek, z ktorego sciezki do celow odtwarzane sa na zadanie.
+        template <template <typename> class Q = BinaryHeap, typename W>
+        static BasicShortestPathTree<W> shortestPathTree(const CSRView<W>& graph, const sizeType& v)
+        {
+            NoStats stats;
+            return shortestPathTree<Q>(graph, v, stats);
+        }
+
+        /// @brief Algorytm Dijkstry wyznaczajacy drzewo najkrotszych sciezek dla migawki grafu w formacie CSR.
+        /// @tparam Q kolejka priorytetowa adresowana indeksem wierzcholka (BinaryHeap, QuaternaryHeap, PairingHeap)
+        /// @tparam W typ wag krawedzi
+        /// @param graph graf w formacie CSR z nieujemnymi wagami krawedzi
+        /// @param v indeks wierzcholka wejsciowego
+        /// @return Zwraca drzewo najkrotszych sciezek, z ktorego sciezki do celow odtwarzane sa na zadanie.
+        template <template <typename> class Q = BinaryHeap, typename W>
+        static BasicShortestPathTree<W> shortestPathTree(const CSRGraph<W>& graph, const sizeType& v)
+            { return shortestPathTree<Q>(graph.view(), v); }
+
+        /// @brief Algorytm Dijkstry wyznaczajacy drzewo najkrotszych sciezek dla migawki grafu w formacie CSR,
+        /// zliczajacy wykonane operacje.
+        /// @tparam Q kolejka priorytetowa adresowana indeksem wierzcholka (BinaryHeap, QuaternaryHeap, PairingHeap)
+        /// @tparam S polityka statystyk (NoStats, CountingStats)
+        /// @tparam W typ wag krawedzi
+        /// @param graph widok grafu w formacie CSR z nieujemnymi wagami krawedzi
+        /// @param v indeks wierzcholka wejsciowego
+        /// @param stats statystyki, do ktorych dopisywane sa operacje algorytmu
+        /// @return Zwraca drzewo najkrotszych sciezek, z ktorego sciezki do celow odtwarzane sa na zadanie.
+        template <template <typename> class Q = BinaryHeap, typename S, typename W>
+        static BasicShortestPathTree<W> shortestPathTree(const CSRView<W>& graph, const sizeType& v, S& stats)
+        {
+            std::vector<W> D(graph.sizeV());
+            std::vector<std::uint32_t> P(graph.sizeV());
+            Q<W> queue(graph.sizeV());
+            shortestPath<true>(graph, v, D.data(), P.data(), queue, stats);
+            return BasicShortestPathTree<W>(v, std::move(D), std::move(P));
+        }
+
+        /// @brief Algorytm Dijkstry wyznaczajacy drzewo najkrotszych sciezek dla migawki grafu w formacie CSR,
+        /// zliczajacy wykonane operacje.
+        /// @tparam Q kolejka priorytetowa adresowana indeksem wierzcholka (BinaryHeap, QuaternaryHeap, PairingHeap)
+        /// @tparam S polityka statystyk (NoStats, CountingStats)
+        /// @tparam W typ wag krawedzi
+        /// @param graph graf w formacie CSR z nieujemnymi wagami krawedzi
+        /// @param v indeks wierzcholka wejsciowego
+        /// @param stats statystyki, do ktorych dopisywane sa operacje algorytmu
+        /// @return Zwraca drzewo najkrotszych sciezek, z ktorego sciezki do celow odtwarzane sa na zadanie.
+        template <template <typename> class Q = BinaryHeap, typename S, typename W>
+        static BasicShortestPathTree<W> shortestPathTree(const CSRGraph<W>& graph, const sizeType& v, S& stats)
+            { return shortestPathTree<Q>(graph.view(), v, stats); }
+
+        /// @brief Algorytm Dijkstry dla migawki grafu w formacie CSR, korzystajacy z pamieci wywolujacego.
+        /// @tparam W typ wag krawedzi
+        /// @tparam Queue kolejka priorytetowa adresowana indeksem wierzcholka, z kluczami typu W
+        /// @tparam S polityka statystyk (NoStats, CountingStats)
+        /// @param graph widok grafu w formacie CSR z nieujemnymi wagami krawedzi
+        /// @param v indeks wierzcholka wejsciowego
+        /// @param D tablica sizeV() elementow, w ktorej zapisywane sa dlugosci sciezek
+        /// @param queue pusta kolejka o pojemnosci co najmniej sizeV(); po zakonczeniu jest znowu pusta
+        /// @param stats statystyki, do ktorych dopisywane sa operacje algorytmu
+        template <typename W, typename Queue, typename S>
+        static void shortestPath(const CSRView<W>& graph, const sizeType& v, W* D, Queue& queue, S& stats)
+            { shortestPath<false>(graph, v, D, nullptr, queue, stats); }
+
+        /// @brief Algorytm Dijkstry dla migawki grafu w formacie CSR, z opcjonalnym zapisem poprzednikow.
+        /// @tparam Predecessors zapis poprzednikow do tablicy P; dla false tablica nie jest uzywana
+        /// @tparam W typ wag krawedzi
+        /// @tparam Queue kolejka priorytetowa adresowana indeksem wierzcholka, z kluczami typu W
+        /// @tparam S polityka statystyk (NoStats, CountingStats)
+        /// @param graph widok grafu w formacie CSR z nieujemnymi wagami krawedzi
+        /// @param v indeks wierzcholka wejsciowego
+        /// @param D tablica sizeV() elementow, w ktorej zapisywane sa dlugosci sciezek
+        /// @param P tablica sizeV() elementow na poprzedniki albo nullptr dla Predecessors == false
+        /// @param queue pusta kolejka o pojemnosci co najmniej sizeV(); po zakonczeniu jest znowu pusta
+        /// @param stats statystyki, do ktorych dopisywane sa operacje algorytmu
+        template <bool Predecessors, typename W, typename Queue, typename S>
+        static void shortestPath(const CSRView<W>& graph, const sizeType& v, W* D, std::uint32_t* P, Queue& queue, S& stats)
+        {
+            TRACE_SPAN("DijkstraAlgorithm::shortestPath(CSR)");
+            std::fill(D, D + graph.sizeV(), WeightTraits<W>::infinity());
+            if constexpr (Predecessors)
+                std::fill(P, P + graph.sizeV(), ShortestPathTree::NONE);
+            D[v] = WeightTraits<W>::zero();
+
+            queue.push(v, D[v]);
+            stats.push();
+
+            while (!queue.empty())
+            {
+                sizeType u = queue.top();
+                queue.pop();
+                stats.pop();
+
+                stats.incidentEdges();
+                for (sizeType k = graph.offset(u); k < graph.offset(u + 1); k++)
+                {
+                    sizeType z = graph.target(k);
+                    stats.relaxAttempt();
+                    if (WeightTraits<W>::improves(D[u], graph.weight(k), D[z]))
+                    {
+                        D[z] = D[u] + graph.weight(k);
+                        if constexpr (Predecessors)
+                            P[z] = static_cast<std::uint32_t>(u);
+                        stats.relaxSuccess();
+                        if constexpr (S::enabled)
+                        {
+                            if (queue.contains(z))
+                                stats.decreaseKey();
+                            else
+                                stats.push();
+                        }
+                        queue.pushOrDecrease(z, D[z]);
+                    }
+                }
+            }
+        }
 };
 
-#endif
\ No newline at end of file
+#endif
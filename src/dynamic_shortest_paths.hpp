@@ -0,0 +1,271 @@
+#ifndef DYNAMIC_SHORTEST_PATHS_HPP
+#define DYNAMIC_SHORTEST_PATHS_HPP
+
+#include <vector>
+#include <climits>
+#include <cstdint>
+#include <algorithm>
+
+#include "graph.hpp"
+#include "priority_queue.hpp"
+#include "algorithm_stats.hpp"
+#include "dijkstra_algorithm.hpp"
+#include "shortest_path_tree.hpp"
+#include "trace.hpp"
+
+/// @brief Najkrotsze sciezki ze stalego zrodla, naprawiane przyrostowo po zmianach grafu (w stylu Ramalingama i Repsa).
+/// Obiekt obserwuje graf i po kazdej zmianie krawedzi przelicza tylko obszar, ktorego ona dotyczy:
+/// - skrocenie lub dodanie krawedzi relaksuje ja w obu kierunkach i propaguje poprawy algorytmem Dijkstry
+///   ograniczonym do wierzcholkow, ktorych odleglosc zmalala,
+/// - wydluzenie lub usuniecie krawedzi drzewa najkrotszych sciezek uniewaznia poddrzewo ponizej niej; wierzcholki
+///   poddrzewa otrzymuja odleglosci kandydujace od sasiadow spoza poddrzewa, a nastepnie sa przeliczane algorytmem
+///   Dijkstry. Zmiana krawedzi spoza drzewa nie zmienia zadnej odleglosci.
+/// Usuniecie wierzcholka zmienia indeksy, wiec powoduje pelne przeliczenie. Obsluguje tylko grafy o wagach int.
+/// @tparam T typ elementow na wierzcholkach
+/// @tparam Q kolejka priorytetowa adresowana indeksem wierzcholka (BinaryHeap, QuaternaryHeap, PairingHeap)
+template <typename T, template <typename> class Q = BinaryHeap>
+class DynamicShortestPaths : public GraphObserver<T,int>
+{
+    public:
+        /// @brief Konstruktor wyznaczajacy odleglosci i rejestrujacy obiekt jako obserwatora grafu.
+        /// @param graph referencja do nieskierowanego grafu prostego z nieujemnymi wagami krawedzi
+        /// @param source referencja do wierzcholka zrodlowego
+        DynamicShortestPaths(GraphADT<T,int>* graph, const Vertex<T,int>* source): graph{graph}, root{source->i}
+        {
+            graph->subscribe(this);
+            recompute();
+        }
+
+        DynamicShortestPaths(const DynamicShortestPaths&) = delete;
+        DynamicShortestPaths& operator=(const DynamicShortestPaths&) = delete;
+
+        ~DynamicShortestPaths()
+        {
+            if (graph)
+                graph->unsubscribe(this);
+        }
+
+        /// @return Zwraca indeks wierzcholka zrodlowego albo ShortestPathTree::NONE, jezeli zrodlo usunieto z grafu.
+        sizeType source() const
+            { return root; }
+
+        /// @return Zwraca aktualne dlugosci sciezek do kazdego wierzcholka (INT_MAX dla nieosiagalnych).
+        const std::vector<int>& distances() const
+            { return D; }
+
+        /// @param target indeks wierzcholka
+        /// @return Zwraca aktualna dlugosc najkrotszej sciezki albo INT_MAX.
+        int distance(const sizeType& target) const
+            { return D[target]; }
+
+        /// @param target indeks wierzcholka
+        /// @return Zwraca poprzednik wierzcholka na najkrotszej sciezce albo ShortestPathTree::NONE.
+        std::uint32_t predecessor(const sizeType& target) const
+            { return P[target]; }
+
+        /// @return Zwraca kopie aktualnego drzewa najkrotszych sciezek.
+        ShortestPathTree tree() const
+            { return ShortestPathTree(root, D, P); }
+
+        /// @return Zwraca statystyki operacji wykonanych przez ostatnia naprawe lub przeliczenie.
+        const CountingStats& lastRepair() const
+            { return stats; }
+
+        /// @brief Wyznacza wszystkie odleglosci od nowa.
+        void recompute()
+        {
+            TRACE_SPAN("DynamicShortestPaths::recompute");
+            stats = CountingStats();
+            const sizeType n = graph ? graph->sizeV() : 0;
+            D.assign(n, INT_MAX);
+            P.assign(n, NONE);
+            mark.assign(n, 0);
+            reserve();
+            if (root != NONE)
+                DijkstraAlgorithm::shortestPath<true>(graph, graph->vertex(root), D.data(), P.data(), queue, stats);
+        }
+
+        void vertexInserted(const Vertex<T,int>* /*v*/)
+        {
+            D.push_back(INT_MAX);
+            P.push_back(NONE);
+            mark.push_back(0);
+        }
+
+        void vertexRemoved(const sizeType& i, const sizeType& moved)
+        {
+            if (root == i)
+                root = NONE;
+            else if (root == moved)
+                root = i;
+            recompute();
+        }
+
+        void edgeInserted(const Edge<T,int>* e)
+            { decrease(e->v->i, e->w->i, e->element); }
+
+        void edgeReplaced(const Edge<T,int>* e, const int& previous)
+        {
+            if (e->element < previous)
+                decrease(e->v->i, e->w->i, e->element);
+            else if (e->element > previous)
+                increase(e->v->i, e->w->i);
+        }
+
+        void edgeRemoved(const Vertex<T,int>* v, const Vertex<T,int>* w, const int& /*x*/)
+            { increase(v->i, w->i); }
+
+        void cleared()
+        {
+            root = NONE;
+            recompute();
+        }
+
+        void detached()
+        {
+            graph = nullptr;
+            root = NONE;
+        }
+
+    private:
+        static constexpr std::uint32_t NONE = ShortestPathTree::NONE;
+
+        /// @brief Zapewnia kolejke o pojemnosci co najmniej liczby wierzcholkow; zwiekszana z zapasem,
+        /// aby dodawanie wierzcholkow nie realokowalo jej za kazdym razem.
+        void reserve()
+        {
+            if (capacity < D.size())
+            {
+                capacity = 2 * D.size();
+                queue.resize(capacity);
+            }
+        }
+
+        /// @brief Krawedz a-b o wadze w zostala skrocona lub dodana.
+        void decrease(const sizeType& a, const sizeType& b, const int& w)
+        {
+            TRACE_SPAN("DynamicShortestPaths::decrease");
+            stats = CountingStats();
+            reserve();
+            relax(a, b, w);
+            relax(b, a, w);
+            propagate();
+        }
+
+        /// @brief Krawedz a-b zostala wydluzona lub usunieta.
+        void increase(const sizeType& a, const sizeType& b)
+        {
+            stats = CountingStats();
+            sizeType child;
+            if (P[b] == a)
+                child = b;
+            else if (P[a] == b)
+                child = a;
+            else
+                return;
+
+            TRACE_SPAN("DynamicShortestPaths::increase");
+            reserve();
+
+            // Poddrzewo ponizej krawedzi: wierzcholki, ktorych najkrotsza sciezka prowadzila przez nia
+            affected.clear();
+            affected.push_back(static_cast<std::uint32_t>(child));
+            mark[child] = 1;
+            for (sizeType k = 0; k < affected.size(); k++)
+            {
+                const Vertex<T,int>* x = graph->vertex(affected[k]);
+                stats.incidentEdges();
+                for (auto e : graph->incidentEdgesRange(x))
+                {
+                    const sizeType y = graph->opposite(x, e)->i;
+                    if (P[y] == x->i && !mark[y])
+                    {
+                        mark[y] = 1;
+                        affected.push_back(static_cast<std::uint32_t>(y));
+                    }
+                }
+            }
+            for (auto & x : affected)
+            {
+                D[x] = INT_MAX;
+                P[x] = NONE;
+            }
+
+            // Odleglosci kandydujace od sasiadow spoza poddrzewa, ktorych odleglosci pozostaja dokladne
+            for (auto & x : affected)
+            {
+                const Vertex<T,int>* vx = graph->vertex(x);
+                stats.incidentEdges();
+                for (auto e : graph->incidentEdgesRange(vx))
+                {
+                    const sizeType y = graph->opposite(vx, e)->i;
+                    stats.relaxAttempt();
+                    if (!mark[y] && e->element < D[x] - D[y])
+                    {
+                        D[x] = D[y] + e->element;
+                        P[x] = static_cast<std::uint32_t>(y);
+                        stats.relaxSuccess();
+                    }
+                }
+                if (D[x] != INT_MAX)
+                {
+                    queue.push(x, D[x]);
+                    stats.push();
+                }
+            }
+            for (auto & x : affected)
+                mark[x] = 0;
+
+            propagate();
+        }
+
+        /// @brief Relaksuje krawedz u-z o wadze w w kierunku z.
+        void relax(const sizeType& u, const sizeType& z, const int& w)
+        {
+            stats.relaxAttempt();
+            // Warunek zapisany jako roznica, aby D[u] + waga nie przekroczylo INT_MAX
+            if (w < D[z] - D[u])
+            {
+                D[z] = D[u] + w;
+                P[z] = static_cast<std::uint32_t>(u);
+                stats.relaxSuccess();
+                if (queue.contains(z))
+                    stats.decreaseKey();
+                else
+                    stats.push();
+                queue.pushOrDecrease(z, D[z]);
+            }
+        }
+
+        /// @brief Algorytm Dijkstry od wierzcholkow znajdujacych sie w kolejce. Odwiedza tylko wierzcholki,
+        /// ktorych odleglosc zmalala, wiec koszt jest proporcjonalny do naprawianego obszaru.
+        void propagate()
+        {
+            while (!queue.empty())
+            {
+                const sizeType u = queue.top();
+                queue.pop();
+                stats.pop();
+
+                const Vertex<T,int>* vu = graph->vertex(u);
+                stats.incidentEdges();
+                for (auto e : graph->incidentEdgesRange(vu))
+                    relax(u, graph->opposite(vu, e)->i, e->element);
+            }
+        }
+
+        GraphADT<T,int>* graph;
+        sizeType root;
+
+        std::vector<int> D;
+        std::vector<std::uint32_t> P;
+
+        // Przestrzen robocza naprawy
+        Q<int> queue;
+        sizeType capacity = 0;
+        std::vector<char> mark;
+        std::vector<std::uint32_t> affected;
+        CountingStats stats;
+};
+
+#endif
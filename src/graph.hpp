@@ -6,8 +6,13 @@
 #include <iterator>
 #include <memory>
 #include <iostream>
+#include <array>
+#include <tuple>
+#include <cstdint>
 
-typedef std::size_t sizeType;
+#include "types.hpp"
+#include "csr_graph.hpp"
+#include "trace.hpp"
 
 /// @brief Klasa bazowa wierzcholka grafu.
 /// @tparam T typ danych na wierzcholkach grafu
@@ -102,6 +107,129 @@ struct Edge
     }
 };
 
+/// @brief Zakres referencji do krawedzi, przechodzony bez alokacji pamieci.
+/// Wskazuje bezposrednio na strukture grafu, puste wpisy (nullptr lub 0) sa pomijane.
+/// Zakres traci waznosc po kazdej modyfikacji grafu.
+/// @tparam T typ danych na wierzcholkach grafu
+/// @tparam W typ danych na krawedziach grafu
+template <typename T, typename W>
+class EdgeRange
+{
+    public:
+        class iterator
+        {
+            public:
+                /// @brief Konstruktor iteratora po wpisach bedacych referencjami do krawedzi.
+                /// @param current pierwszy wpis zakresu
+                /// @param last wpis za ostatnim wpisem zakresu
+                iterator(Edge<T,W>* const* current, Edge<T,W>* const* last):
+                    pointer{current}, pointerLast{last} { skip(); }
+
+                /// @brief Konstruktor iteratora po wpisach bedacych indeksami krawedzi powiekszonymi o 1 (0 - brak krawedzi).
+                /// @param current pierwszy wpis zakresu
+                /// @param last wpis za ostatnim wpisem zakresu
+                /// @param table struktura krawedzi grafu
+                iterator(const std::uint32_t* current, const std::uint32_t* last, Edge<T,W>* const* table):
+                    index{current}, indexLast{last}, table{table} { skip(); }
+
+                Edge<T,W>* operator*() const
+                    { return index ? table[*index - 1] : *pointer; }
+
+                iterator& operator++()
+                {
+                    if (index)
+                        ++index;
+                    else
+                        ++pointer;
+                    skip();
+                    return *this;
+                }
+
+                bool operator==(const iterator& other) const
+                    { return pointer == other.pointer && index == other.index; }
+
+                bool operator!=(const iterator& other) const
+                    { return !(*this == other); }
+
+            private:
+                void skip()
+                {
+                    if (index)
+                        while (index != indexLast && !*index)
+                            ++index;
+                    else
+                        while (pointer != pointerLast && !*pointer)
+                            ++pointer;
+                }
+
+                Edge<T,W>* const* pointer = nullptr;
+                Edge<T,W>* const* pointerLast = nullptr;
+                const std::uint32_t* index = nullptr;
+                const std::uint32_t* indexLast = nullptr;
+                Edge<T,W>* const* table = nullptr;
+        };
+
+        /// @brief Konstruktor zakresu wpisow bedacych referencjami do krawedzi.
+        /// @param first pierwszy wpis zakresu
+        /// @param last wpis za ostatnim wpisem zakresu
+        EdgeRange(Edge<T,W>* const* first, Edge<T,W>* const* last):
+            first{first, last}, last{last, last} {}
+
+        /// @brief Konstruktor zakresu wpisow bedacych indeksami krawedzi powiekszonymi o 1 (0 - brak krawedzi).
+        /// @param first pierwszy wpis zakresu
+        /// @param last wpis za ostatnim wpisem zakresu
+        /// @param table struktura krawedzi grafu
+        EdgeRange(const std::uint32_t* first, const std::uint32_t* last, Edge<T,W>* const* table):
+            first{first, last, table}, last{last, last, table} {}
+
+        iterator begin() const
+            { return first; }
+
+        iterator end() const
+            { return last; }
+
+    private:
+        iterator first;
+        iterator last;
+};
+
+/// @brief Interfejs obiektu powiadamianego o zmianach grafu. Powiadomienia wysylane sa po wykonaniu zmiany,
+/// wiec w trakcie ich obslugi graf jest spojny. Domyslne implementacje ignoruja zdarzenia.
+/// @tparam T typ danych na wierzcholkach grafu
+/// @tparam W typ danych na krawedziach grafu
+template <typename T, typename W>
+class GraphObserver
+{
+    public:
+        virtual ~GraphObserver() = default;
+
+        /// @param v nowo dodany wierzcholek
+        virtual void vertexInserted(const Vertex<T,W>* /*v*/) {}
+
+        /// @brief Wierzcholek zostal usuniety (po wczesniejszych powiadomieniach o usunieciu jego krawedzi).
+        /// @param i indeks usunietego wierzcholka
+        /// @param moved dotychczasowy indeks wierzcholka, ktory przejal indeks i (moved == i, jezeli usunieto ostatni)
+        virtual void vertexRemoved(const sizeType& /*i*/, const sizeType& /*moved*/) {}
+
+        /// @param e nowo dodana krawedz
+        virtual void edgeInserted(const Edge<T,W>* /*e*/) {}
+
+        /// @param e krawedz, ktorej wartosc zmieniono
+        /// @param previous poprzednia wartosc na krawedzi
+        virtual void edgeReplaced(const Edge<T,W>* /*e*/, const W& /*previous*/) {}
+
+        /// @param v jeden z wierzcholkow koncowych usunietej krawedzi
+        /// @param w drugi z wierzcholkow koncowych usunietej krawedzi
+        /// @param x wartosc przechowywana na usunietej krawedzi
+        virtual void edgeRemoved(const Vertex<T,W>* /*v*/, const Vertex<T,W>* /*w*/, const W& /*x*/) {}
+
+        /// @brief Graf zostal wyczyszczony.
+        virtual void cleared() {}
+
+        /// @brief Graf jest niszczony; obserwator nie moze sie juz do niego odwolywac.
+        virtual void detached() {}
+};
+
 /// @brief Klasa abstrakcyjna, tworzaca schemat dla dzialania implementacji grafu.
 /// @tparam T typ danych na wierzcholkach grafu
 /// @tparam W typ danych na krawedziach grafu
@@ -109,6 +237,16 @@ template <typename T, typename W>
 class GraphADT
 {
     public:
+        /// @brief Lista krawedzi do wstawienia: (indeks v, indeks w, wartosc) z indeksami wierzcholkow Vertex::i.
+        /// Indeksy sa 32-bitowe, jak w migawce CSR, aby lista zajmowala jak najmniej pamieci.
+        typedef std::vector<std::tuple<std::uint32_t, std::uint32_t, W>> EdgeList;
+
+        virtual ~GraphADT()
+        {
+            for (auto & o : observers)
+                o->detached();
+        }
+
         // Metody dostepu
 
         /// @return Zwraca rozmiar struktury przechowujacej wierzcholki.
@@ -159,6 +297,37 @@ class GraphADT
         /// @return Zwraca referencje do nowo utworzonej krawedzi.
         virtual Edge<T,W>* insertEdge(Vertex<T,W>* v, Vertex<T,W>* w, const W& x) = 0;
 
+        /// @brief Rezerwuje pamiec tak, aby graf mogl osiagnac podana liczbe wierzcholkow i krawedzi
+        /// bez realokacji struktur. Domyslnie nic nie robi.
+        /// @param verticesNumber docelowa liczba wierzcholkow
+        /// @param edgesNumber docelowa liczba krawedzi
+        virtual void reserve(const sizeType& /*verticesNumber*/, const sizeType& /*edgesNumber*/) {}
+
+        /// @brief Dodaje zbior krawedzi do grafu w kolejnosci listy, z jedna rezerwacja pamieci.
+        /// Obserwatorzy otrzymuja powiadomienie o kazdej krawedzi.
+        /// @param edges krawedzie miedzy istniejacymi wierzcholkami
+        virtual void insertEdges(const EdgeList& edges)
+        {
+            TRACE_SPAN("GraphADT::insertEdges");
+            reserve(sizeV(), sizeE() + edges.size());
+            for (auto & e : edges)
+                insertEdge(vertex(std::get<0>(e)), vertex(std::get<1>(e)), std::get<2>(e));
+        }
+
+        /// @brief Zastepuje zawartosc grafu wierzcholkami o podanych wartosciach i krawedziami z listy.
+        /// Wierzcholek i otrzymuje wartosc elements[i], a pamiec rezerwowana jest jednorazowo.
+        /// @param elements wartosci kolejnych wierzcholkow
+        /// @param edges krawedzie (indeksy odnosza sie do pozycji w elements)
+        void fromEdgeList(const std::vector<T>& elements, const EdgeList& edges)
+        {
+            TRACE_SPAN("GraphADT::fromEdgeList");
+            clear();
+            reserve(elements.size(), edges.size());
+            for (auto & x : elements)
+                insertVertex(x);
+            insertEdges(edges);
+        }
+
         /// @brief Usuwa wierzcholek z grafu.
         /// @param v referencja do wierzcholka w grafie
         virtual void removeVertex(Vertex<T,W>* const v) = 0;
@@ -167,6 +336,15 @@ class GraphADT
         /// @param e referencja do krawedzi w grafie
         virtual void removeEdge(Edge<T,W>* const e) = 0;
 
+        /// @brief Usuwa zbior krawedzi z grafu. Indeksy pozostalych krawedzi moga ulec zmianie.
+        /// @param edges referencje do krawedzi w grafie, kazda co najwyzej raz
+        virtual void removeEdges(const std::vector<Edge<T,W>*>& edges)
+        {
+            TRACE_SPAN("GraphADT::removeEdges");
+            for (auto & e : edges)
+                removeEdge(e);
+        }
+
         /// @brief "Czysci" graf. Wynikiem dzialania jest pusta struktura.
         virtual void clear() = 0;
 
@@ -182,6 +360,116 @@ class GraphADT
         
         /// @return Zwraca std::vector przechowujacy referencje do wszystkich krawedzi w grafie.
         virtual std::vector<Edge<T,W>*> edges() const = 0;
+
+        /// @brief Wersja incidentEdges bez alokacji pamieci.
+        /// @param v referencja do wierzcholka w grafie
+        /// @return Zwraca zakres krawedzi incydentnych, wazny do nastepnej modyfikacji grafu.
+        virtual EdgeRange<T,W> incidentEdgesRange(const Vertex<T,W>* const v) const = 0;
+
+        /// @param i indeks wierzcholka (Vertex::i)
+        /// @return Zwraca referencje do wierzcholka o danym indeksie.
+        virtual Vertex<T,W>* vertex(const sizeType& i) const = 0;
+
+        /// @param i indeks krawedzi (Edge::i)
+        /// @return Zwraca referencje do krawedzi o danym indeksie.
+        virtual Edge<T,W>* edge(const sizeType& i) const = 0;
+
+        /// @return Zwraca prawde jezeli przeglad krawedzi incydentnych kosztuje O(V) niezaleznie od stopnia
+        /// wierzcholka (np. macierz sasiedztwa). Pozwala algorytmom wybrac wariant dla grafow gestych.
+        virtual bool denseStorage() const
+            { return false; }
+
+
+        // Obserwatorzy
+
+        /// @brief Rejestruje obiekt powiadamiany o zmianach grafu. Bez zarejestrowanych obserwatorow
+        /// powiadomienia kosztuja jedno sprawdzenie pustej listy.
+        /// @param observer obserwator, ktory musi wyrejestrowac sie przed zniszczeniem
+        void subscribe(GraphObserver<T,W>* observer)
+            { observers.push_back(observer); }
+
+        /// @brief Wyrejestrowuje obserwatora.
+        /// @param observer obserwator
+        void unsubscribe(GraphObserver<T,W>* observer)
+        {
+            for (sizeType k = 0; k < observers.size(); k++)
+                if (observers[k] == observer)
+                {
+                    observers.erase(observers.begin() + k);
+                    return;
+                }
+        }
+
+
+        // Migawki
+
+        /// @brief Tworzy niemodyfikowalna migawke grafu w formacie CSR. Indeksy wierzcholkow w migawce
+        /// odpowiadaja Vertex::i, a pozniejsze zmiany grafu nie sa w niej widoczne.
+        /// @return Zwraca graf w formacie CSR.
+        CSRGraph<W> freeze() const
+        {
+            TRACE_SPAN("GraphADT::freeze");
+            std::vector<sizeType> offsets(sizeV() + 1, 0);
+            std::vector<std::uint32_t> targets;
+            std::vector<W> weights;
+            targets.reserve(2 * sizeE());
+            weights.reserve(2 * sizeE());
+
+            for (sizeType i = 0; i < sizeV(); i++)
+            {
+                const Vertex<T,W>* v = vertex(i);
+                for (auto e : incidentEdgesRange(v))
+                {
+                    targets.push_back(static_cast<std::uint32_t>(opposite(v, e)->i));
+                    weights.push_back(e->element);
+                }
+                offsets[i + 1] = targets.size();
+            }
+
+            return CSRGraph<W>(std::move(offsets), std::move(targets), std::move(weights));
+        }
+
+    protected:
+        // Powiadomienia wywolywane przez implementacje po kazdej zmianie grafu
+
+        void notifyVertexInserted(const Vertex<T,W>* v) const
+        {
+            for (auto & o : observers)
+                o->vertexInserted(v);
+        }
+
+        void notifyVertexRemoved(const sizeType& i, const sizeType& moved) const
+        {
+            for (auto & o : observers)
+                o->vertexRemoved(i, moved);
+        }
+
+        void notifyEdgeInserted(const Edge<T,W>* e) const
+        {
+            for (auto & o : observers)
+                o->edgeInserted(e);
+        }
+
+        void notifyEdgeReplaced(const Edge<T,W>* e, const W& previous) const
+        {
+            for (auto & o : observers)
+                o->edgeReplaced(e, previous);
+        }
+
+        void notifyEdgeRemoved(const Vertex<T,W>* v, const Vertex<T,W>* w, const W& x) const
+        {
+            for (auto & o : observers)
+                o->edgeRemoved(v, w, x);
+        }
+
+        void notifyCleared() const
+        {
+            for (auto & o : observers)
+                o->cleared();
+        }
+
+    private:
+        std::vector<GraphObserver<T,W>*> observers;
 };
 
 #endif
\ No newline at end of file
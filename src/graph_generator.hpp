@@ -0,0 +1,300 @@
+#ifndef GRAPH_GENERATOR_HPP
+#define GRAPH_GENERATOR_HPP
+
+#include <vector>
+#include <unordered_set>
+#include <algorithm>
+#include <random>
+#include <cmath>
+#include <cstdint>
+#include <climits>
+
+#include "graph.hpp"
+
+/// @brief Generator losowych grafow nieskierowanych z jawnym ziarnem i trwalym silnikiem losujacym.
+/// Wszystkie modele dzialaja w czasie O(V + E). Wierzcholki otrzymuja wartosci 1..n, a wagi krawedzi
+/// losowane sa jednostajnie z przedzialu [minWeight, maxWeight].
+class GraphGenerator
+{
+    public:
+        /// @brief Podstawowy konstruktor generatora.
+        /// @param seed ziarno silnika losujacego
+        GraphGenerator(const std::uint64_t& seed = 5489u): engine(seed), seedValue{seed} {}
+
+        /// @brief Ustawia nowe ziarno i restartuje silnik losujacy.
+        /// @param seed ziarno silnika losujacego
+        void seed(const std::uint64_t& seed)
+        {
+            engine.seed(seed);
+            seedValue = seed;
+        }
+
+        /// @return Zwraca ostatnio ustawione ziarno.
+        std::uint64_t seed() const
+            { return seedValue; }
+
+        /// @return Zwraca silnik losujacy generatora.
+        std::mt19937_64& randomEngine()
+            { return engine; }
+
+        /// @param min wartosc minimalna zakresu
+        /// @param max wartosc maksymalna zakresu
+        /// @return Zwraca losowa wartosc integer z zakresu (wlacznie)
+        int randomInt(const int& min, const int& max)
+            { return std::uniform_int_distribution<int>(min, max)(engine); }
+
+        /// @brief Tworzy losowy nieskierowany graf prosty o dokladnie density * n * (n - 1) / 2 krawedziach.
+        /// Indeksy krawedzi losowane sa bez powtorzen (algorytm Floyda), a przy gestosci powyzej 1/2
+        /// losowane jest dopelnienie, wiec czas dzialania wynosi O(V + E).
+        /// @param graph referencja do grafu
+        /// @param verticesNumber docelowa liczba wierzcholkow
+        /// @param density docelowa gestosc grafu
+        /// @param minWeight minimalna waga krawedzi
+        /// @param maxWeight maksymalna waga krawedzi
+        void simpleUndirected(GraphADT<int,int>* graph, const int& verticesNumber, const double& density,
+                              const int& minWeight = 1, const int& maxWeight = INT_MAX - 1)
+        {
+            TRACE_SPAN("GraphGenerator::simpleUndirected");
+            std::uniform_int_distribution<int> weight(minWeight, maxWeight);
+
+            const std::uint64_t n = verticesNumber;
+            const std::uint64_t pairs = n * (n - 1) / 2;
+            std::uint64_t target = static_cast<std::uint64_t>(density * verticesNumber * (verticesNumber - 1) / 2);
+            if (target > pairs)
+                target = pairs;
+
+            const sizeType first = insertVertices(graph, verticesNumber, target);
+            GraphADT<int,int>::EdgeList edges;
+            edges.reserve(target);
+            if (target > pairs / 2)
+            {
+                // Losowanie par pominietych i przejscie po wszystkich parach
+                PairSet skipped = samplePairs(pairs, pairs - target, nullptr);
+                std::uint64_t k = 0;
+                for (std::uint64_t v = 1; v < n; v++)
+                    for (std::uint64_t w = 0; w < v; w++, k++)
+                        if (!skipped.count(k))
+                            edges.emplace_back(first + v, first + w, weight(engine));
+            }
+            else
+            {
+                std::vector<std::uint64_t> chosen;
+                samplePairs(pairs, target, &chosen);
+                for (auto & k : chosen)
+                {
+                    std::uint64_t v, w;
+                    decodePair(k, v, w);
+                    edges.emplace_back(first + v, first + w, weight(engine));
+                }
+            }
+            graph->insertEdges(edges);
+        }
+
+        /// @brief Tworzy graf losowy Erdosa-Renyiego G(n, p), pomijajac nieistniejace krawedzie skokami
+        /// o rozkladzie geometrycznym (Batagelj, Brandes).
+        /// @param graph referencja do grafu
+        /// @param verticesNumber liczba wierzcholkow
+        /// @param p prawdopodobienstwo istnienia kazdej krawedzi
+        /// @param minWeight minimalna waga krawedzi
+        /// @param maxWeight maksymalna waga krawedzi
+        void gnp(GraphADT<int,int>* graph, const int& verticesNumber, const double& p,
+                 const int& minWeight = 1, const int& maxWeight = INT_MAX - 1)
+        {
+            TRACE_SPAN("GraphGenerator::gnp");
+            const sizeType expected = p > 0 ? static_cast<sizeType>(std::min(p, 1.0) * 0.5 * verticesNumber * (verticesNumber - 1.0)) : 0;
+            const sizeType first = insertVertices(graph, verticesNumber, expected);
+            std::uniform_int_distribution<int> weight(minWeight, maxWeight);
+            if (p <= 0)
+                return;
+
+            GraphADT<int,int>::EdgeList edges;
+            edges.reserve(expected);
+            if (p >= 1)
+            {
+                for (int v = 1; v < verticesNumber; v++)
+                    for (int w = 0; w < v; w++)
+                        edges.emplace_back(first + v, first + w, weight(engine));
+                graph->insertEdges(edges);
+                return;
+            }
+
+            std::uniform_real_distribution<double> uniform(0.0, 1.0);
+            const double logQ = std::log(1.0 - p);
+            std::int64_t v = 1;
+            std::int64_t w = -1;
+            while (v < verticesNumber)
+            {
+                w += 1 + static_cast<std::int64_t>(std::floor(std::log(1.0 - uniform(engine)) / logQ));
+                while (w >= v && v < verticesNumber)
+                {
+                    w -= v;
+                    ++v;
+                }
+                if (v < verticesNumber)
+                    edges.emplace_back(first + v, first + w, weight(engine));
+            }
+            graph->insertEdges(edges);
+        }
+
+        /// @brief Tworzy graf bezskalowy Barabasiego-Alberta. Zaczyna od kliki m + 1 wierzcholkow, a kazdy
+        /// kolejny wierzcholek laczy sie z m roznymi wierzcholkami wybranymi proporcjonalnie do stopnia.
+        /// @param graph referencja do grafu
+        /// @param verticesNumber liczba wierzcholkow
+        /// @param m liczba krawedzi dodawanych z kazdym wierzcholkiem
+        /// @param minWeight minimalna waga krawedzi
+        /// @param maxWeight maksymalna waga krawedzi
+        void barabasiAlbert(GraphADT<int,int>* graph, const int& verticesNumber, const int& m,
+                            const int& minWeight = 1, const int& maxWeight = INT_MAX - 1)
+        {
+            TRACE_SPAN("GraphGenerator::barabasiAlbert");
+            const sizeType expected = static_cast<sizeType>(verticesNumber) * m;
+            const sizeType first = insertVertices(graph, verticesNumber, expected);
+            std::uniform_int_distribution<int> weight(minWeight, maxWeight);
+            GraphADT<int,int>::EdgeList edges;
+            edges.reserve(expected);
+
+            // Kazdy wierzcholek wystepuje tu tyle razy, ile wynosi jego stopien
+            std::vector<int> endpoints;
+            endpoints.reserve(2 * static_cast<sizeType>(verticesNumber) * m);
+
+            const int initial = m + 1 < verticesNumber ? m + 1 : verticesNumber;
+            for (int v = 1; v < initial; v++)
+                for (int w = 0; w < v; w++)
+                {
+                    edges.emplace_back(first + v, first + w, weight(engine));
+                    endpoints.push_back(v);
+                    endpoints.push_back(w);
+                }
+
+            std::vector<int> targets;
+            for (int v = initial; v < verticesNumber; v++)
+            {
+                targets.clear();
+                std::uniform_int_distribution<sizeType> pick(0, endpoints.size() - 1);
+                while (static_cast<int>(targets.size()) < m)
+                {
+                    int w = endpoints[pick(engine)];
+                    bool repeated = false;
+                    for (auto & t : targets)
+                        repeated = repeated || t == w;
+                    if (!repeated)
+                        targets.push_back(w);
+                }
+                for (auto & w : targets)
+                {
+                    edges.emplace_back(first + v, first + w, weight(engine));
+                    endpoints.push_back(v);
+                    endpoints.push_back(w);
+                }
+            }
+            graph->insertEdges(edges);
+        }
+
+        /// @brief Tworzy siatke rows x cols, w ktorej kazdy wierzcholek laczy sie z sasiadem z prawej i z dolu.
+        /// Przypomina to siec drogowa o malym stopniu wierzcholkow i duzej srednicy.
+        /// @param graph referencja do grafu
+        /// @param rows liczba wierszy siatki
+        /// @param cols liczba kolumn siatki
+        /// @param minWeight minimalna waga krawedzi
+        /// @param maxWeight maksymalna waga krawedzi
+        void grid(GraphADT<int,int>* graph, const int& rows, const int& cols,
+                  const int& minWeight = 1, const int& maxWeight = INT_MAX - 1)
+        {
+            TRACE_SPAN("GraphGenerator::grid");
+            const sizeType expected = 2 * static_cast<sizeType>(rows) * cols;
+            const sizeType first = insertVertices(graph, rows * cols, expected);
+            std::uniform_int_distribution<int> weight(minWeight, maxWeight);
+            GraphADT<int,int>::EdgeList edges;
+            edges.reserve(expected);
+
+            for (int r = 0; r < rows; r++)
+                for (int c = 0; c < cols; c++)
+                {
+                    const sizeType x = first + r * cols + c;
+                    if (c + 1 < cols)
+                        edges.emplace_back(x, x + 1, weight(engine));
+                    if (r + 1 < rows)
+                        edges.emplace_back(x, x + cols, weight(engine));
+                }
+            graph->insertEdges(edges);
+        }
+
+    private:
+        /// @brief Zbior liczb z przedzialu [0, range): mapa bitowa, gdy zajmuje nie wiecej niz 8 bajtow na element,
+        /// a w przeciwnym razie tablica mieszajaca.
+        class PairSet
+        {
+            public:
+                PairSet(const std::uint64_t& range, const std::uint64_t& count): dense{range <= 64 * count}
+                {
+                    if (dense)
+                        bits.assign(range / 64 + 1, 0);
+                    else
+                        hashed.reserve(count);
+                }
+
+                bool count(const std::uint64_t& k) const
+                    { return dense ? (bits[k / 64] >> (k % 64)) & 1 : hashed.count(k) != 0; }
+
+                void insert(const std::uint64_t& k)
+                {
+                    if (dense)
+                        bits[k / 64] |= std::uint64_t(1) << (k % 64);
+                    else
+                        hashed.insert(k);
+                }
+
+            private:
+                bool dense;
+                std::vector<std::uint64_t> bits;
+                std::unordered_set<std::uint64_t> hashed;
+        };
+
+        /// @brief Dodaje do grafu wierzcholki o wartosciach 1..n i rezerwuje miejsce na krawedzie.
+        /// @param edgesNumber spodziewana liczba dodawanych krawedzi
+        /// @return Zwraca indeks pierwszego dodanego wierzcholka.
+        static sizeType insertVertices(GraphADT<int,int>* graph, const int& verticesNumber, const sizeType& edgesNumber)
+        {
+            const sizeType first = graph->sizeV();
+            graph->reserve(first + verticesNumber, graph->sizeE() + edgesNumber);
+            for (int i = 0; i < verticesNumber; i++)
+                graph->insertVertex(i + 1);
+            return first;
+        }
+
+        /// @brief Losuje count roznych liczb z przedzialu [0, range) algorytmem Floyda w czasie O(count).
+        /// @param order jezeli rozny od nullptr, otrzymuje wylosowane liczby w kolejnosci losowania
+        /// @return Zwraca zbior wylosowanych liczb.
+        PairSet samplePairs(const std::uint64_t& range, const std::uint64_t& count, std::vector<std::uint64_t>* order)
+        {
+            PairSet chosen(range, count);
+            if (order)
+                order->reserve(count);
+            for (std::uint64_t j = range - count; j < range; j++)
+            {
+                std::uint64_t t = std::uniform_int_distribution<std::uint64_t>(0, j)(engine);
+                if (chosen.count(t))
+                    t = j;
+                chosen.insert(t);
+                if (order)
+                    order->push_back(t);
+            }
+            return chosen;
+        }
+
+        /// @brief Zamienia indeks pary k na wierzcholki (v, w), w < v, przy numeracji k = v * (v - 1) / 2 + w.
+        static void decodePair(const std::uint64_t& k, std::uint64_t& v, std::uint64_t& w)
+        {
+            v = static_cast<std::uint64_t>((1.0 + std::sqrt(1.0 + 8.0 * static_cast<double>(k))) / 2.0);
+            while (v * (v - 1) / 2 > k)
+                --v;
+            while ((v + 1) * v / 2 <= k)
+                ++v;
+            w = k - v * (v - 1) / 2;
+        }
+
+        std::mt19937_64 engine;
+        std::uint64_t seedValue;
+};
+
+#endif
@@ -0,0 +1,366 @@
+#ifndef GRAPH_LOADER_HPP
+#define GRAPH_LOADER_HPP
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <memory>
+#include <climits>
+#include <cstdint>
+#include <algorithm>
+
+#include "graph.hpp"
+#include "csr_graph.hpp"
+#include "thread_pool.hpp"
+#include "trace.hpp"
+
+/// @brief Format pliku z lista krawedzi.
+enum class GraphFormat
+{
+    /// DIMACS (.gr): komentarze "c", naglowek "p sp n m", luki "a u v w" z wierzcholkami numerowanymi od 1.
+    DIMACS,
+    /// SNAP: komentarze "#", wiersze "u v [w]" z wierzcholkami numerowanymi od 0 i waga domyslna 1.
+    SNAP
+};
+
+/// @brief Strumieniowy import grafow nieskierowanych z plikow DIMACS i SNAP.
+/// Plik czytany jest paczkami o stalym rozmiarze, a kazda paczka dzielona jest na granicach wierszy miedzy watki
+/// puli, ktore parsuja liczby recznie, bez strumieni. Wczytanie do migawki CSR czyta plik dwukrotnie, aby poza
+/// migawka potrzebowac tylko paczki i tablicy stopni; wczytanie do budowniczego gromadzi wszystkie krawedzie.
+/// Luki skierowane traktowane sa jako krawedzie nieskierowane, a petle i powtorzenia (np. oba kierunki luku
+/// w DIMACS) sa usuwane, z pozostawieniem najmniejszej wagi.
+class GraphLoader
+{
+    public:
+        /// @brief Domyslny rozmiar paczki wczytywanej z pliku.
+        static constexpr sizeType CHUNK_SIZE = sizeType(16) << 20;
+
+        /// @brief Konstruktor tworzacy wlasna pule watkow.
+        /// @param threads liczba watkow (0 - liczba rdzeni)
+        /// @param chunkSize rozmiar paczki w bajtach
+        GraphLoader(const sizeType& threads = 0, const sizeType& chunkSize = CHUNK_SIZE):
+            ownedPool{new ThreadPool(threads)}, pool{ownedPool.get()}, chunkSize{std::max<sizeType>(chunkSize, 1)} {}
+
+        /// @brief Konstruktor korzystajacy z istniejacej puli watkow.
+        /// @param pool pula watkow, ktora musi istniec dluzej niz ten obiekt
+        /// @param chunkSize rozmiar paczki w bajtach
+        GraphLoader(ThreadPool& pool, const sizeType& chunkSize = CHUNK_SIZE):
+            pool{&pool}, chunkSize{std::max<sizeType>(chunkSize, 1)} {}
+
+        /// @param filePath sciezka do pliku
+        /// @return Zwraca format odgadniety z rozszerzenia: DIMACS dla ".gr", SNAP dla pozostalych.
+        static GraphFormat detect(const std::string& filePath)
+        {
+            const std::string suffix = ".gr";
+            const bool dimacs = filePath.size() >= suffix.size() &&
+                                filePath.compare(filePath.size() - suffix.size(), suffix.size(), suffix) == 0;
+            return dimacs ? GraphFormat::DIMACS : GraphFormat::SNAP;
+        }
+
+        /// @brief Wczytuje krawedzie z pliku do budowniczego CSR. Budowniczy przechowuje wszystkie krawedzie do
+        /// wywolania build(), wiec pamiec rosnie z rozmiarem pliku.
+        /// @param filePath sciezka do pliku
+        /// @param format format pliku
+        /// @param builder budowniczy, do ktorego dodawane sa krawedzie
+        /// @return Zwraca falsz, jezeli pliku nie mozna odczytac albo zawiera niepoprawny wiersz.
+        bool load(const std::string& filePath, const GraphFormat& format, CSRBuilder<int>& builder)
+        {
+            TRACE_SPAN("GraphLoader::load");
+            File file(std::fopen(filePath.c_str(), "rb"), std::fclose);
+            if (!file)
+                return false;
+
+            sizeType declared = 0;
+            const bool valid = scan(file.get(), format, [&](const Slice& s)
+            {
+                if (s.declared)
+                {
+                    declared = s.declared;
+                    builder.resize(declared);
+                }
+                builder.append(s.arcs);
+            });
+            // Krawedzie DIMACS musza miescic sie w liczbie wierzcholkow z naglowka
+            return valid && (format != GraphFormat::DIMACS || declared == 0 || builder.sizeV() == declared);
+        }
+
+        /// @brief Wczytuje graf z pliku do migawki CSR w dwoch przejsciach po pliku. Pierwsze zlicza stopnie
+        /// wierzcholkow, a drugie wpisuje sasiadow bezposrednio na ich miejsca w tablicach migawki, wiec oprocz
+        /// migawki potrzebna jest tylko paczka pliku z krawedziami i tablica poczatkow list sasiadow.
+        /// @param filePath sciezka do pliku
+        /// @param format format pliku
+        /// @param graph migawka, ktora otrzymuje wczytany graf
+        /// @return Zwraca falsz, jezeli pliku nie mozna odczytac albo zawiera niepoprawny wiersz; migawka pozostaje wtedy bez zmian.
+        bool load(const std::string& filePath, const GraphFormat& format, CSRGraph<int>& graph)
+        {
+            TRACE_SPAN("GraphLoader::load(CSR)");
+            File file(std::fopen(filePath.c_str(), "rb"), std::fclose);
+            if (!file)
+                return false;
+
+            // Pierwsze przejscie: offsets[v + 1] zlicza krawedzie wierzcholka v (bez petli)
+            std::vector<sizeType> offsets(1, 0);
+            sizeType declared = 0;
+            bool valid = scan(file.get(), format, [&](const Slice& s)
+            {
+                if (s.declared)
+                {
+                    declared = s.declared;
+                    offsets.resize(std::max<sizeType>(offsets.size(), declared + 1), 0);
+                }
+                for (auto & e : s.arcs)
+                {
+                    const sizeType last = std::max(e.u, e.v);
+                    if (last + 2 > offsets.size())
+                        offsets.resize(last + 2, 0);
+                    if (e.u == e.v)
+                        continue;
+                    offsets[e.u + 1]++;
+                    offsets[e.v + 1]++;
+                }
+            });
+            const sizeType vertices = offsets.size() - 1;
+            if (!valid || (format == GraphFormat::DIMACS && declared != 0 && vertices != declared))
+                return false;
+            for (sizeType v = 0; v < vertices; v++)
+                offsets[v + 1] += offsets[v];
+
+            // Drugie przejscie: rozmieszczenie sasiadow; plik zmieniony miedzy przejsciami jest odrzucany
+            std::vector<std::uint32_t> targets(offsets[vertices]);
+            std::vector<int> weights(offsets[vertices]);
+            std::vector<sizeType> next(offsets.begin(), offsets.end() - 1);
+            bool consistent = true;
+            std::rewind(file.get());
+            valid = scan(file.get(), format, [&](const Slice& s)
+            {
+                for (auto & e : s.arcs)
+                {
+                    if (e.u == e.v)
+                        continue;
+                    if (std::max(e.u, e.v) >= vertices || next[e.u] == offsets[e.u + 1] || next[e.v] == offsets[e.v + 1])
+                    {
+                        consistent = false;
+                        return;
+                    }
+                    targets[next[e.u]] = e.v;
+                    weights[next[e.u]++] = e.w;
+                    targets[next[e.v]] = e.u;
+                    weights[next[e.v]++] = e.w;
+                }
+            });
+            if (!valid || !consistent || next.back() != offsets[vertices])
+                return false;
+            std::vector<sizeType>().swap(next);
+
+            CSRBuilder<int>::removeDuplicates(offsets, targets, weights);
+            graph = CSRGraph<int>(std::move(offsets), std::move(targets), std::move(weights));
+            return true;
+        }
+
+        /// @brief Wczytuje graf z pliku do pustego grafu. Wierzcholki otrzymuja wartosci 1..n, jak w GraphGenerator.
+        /// Graf budowany jest z migawki CSR przez liste krawedzi, wiec chwilowo w pamieci sa wszystkie trzy.
+        /// @param filePath sciezka do pliku
+        /// @param format format pliku
+        /// @param graph referencja do pustego grafu
+        /// @return Zwraca falsz, jezeli pliku nie mozna odczytac albo zawiera niepoprawny wiersz; graf pozostaje wtedy pusty.
+        bool load(const std::string& filePath, const GraphFormat& format, GraphADT<int,int>* graph)
+        {
+            CSRGraph<int> csr;
+            if (!load(filePath, format, csr))
+                return false;
+            insert(csr, graph);
+            return true;
+        }
+
+        /// @brief Zastepuje zawartosc grafu wierzcholkami o wartosciach 1..n i krawedziami migawki (kazda jeden raz).
+        /// @param csr migawka grafu nieskierowanego
+        /// @param graph referencja do grafu
+        static void insert(const CSRView<int>& csr, GraphADT<int,int>* graph)
+        {
+            TRACE_SPAN("GraphLoader::insert");
+            std::vector<int> elements(csr.sizeV());
+            GraphADT<int,int>::EdgeList edges;
+            edges.reserve(csr.sizeE() / 2);
+            for (sizeType v = 0; v < csr.sizeV(); v++)
+            {
+                elements[v] = static_cast<int>(v + 1);
+                for (sizeType k = csr.offset(v); k < csr.offset(v + 1); k++)
+                    if (csr.target(k) > v)
+                        edges.emplace_back(v, csr.target(k), csr.weight(k));
+            }
+            graph->fromEdgeList(elements, edges);
+        }
+
+    private:
+        typedef std::unique_ptr<std::FILE, int(*)(std::FILE*)> File;
+
+        /// @brief Wynik parsowania fragmentu paczki przez jeden watek.
+        struct Slice
+        {
+            std::vector<CSRBuilder<int>::Arc> arcs;
+            sizeType declared = 0;
+            bool valid = true;
+        };
+
+        /// @brief Czyta plik od biezacej pozycji paczkami i przekazuje kolejno wyniki parsowania fragmentow.
+        /// @param consume funkcja (const Slice&) wywolywana dla fragmentow w kolejnosci pliku
+        /// @return Zwraca falsz, jezeli pliku nie mozna odczytac albo zawiera niepoprawny wiersz.
+        template <typename F>
+        bool scan(std::FILE* file, const GraphFormat& format, const F& consume)
+        {
+            std::vector<Slice> slices(4 * pool->size());
+            std::vector<char> buffer(chunkSize);
+            sizeType carried = 0;
+            bool done = false;
+            while (!done)
+            {
+                // Niedokonczony wiersz z poprzedniej paczki przeniesiony jest na poczatek bufora
+                if (carried == buffer.size())
+                    buffer.resize(2 * buffer.size());
+                const sizeType read = std::fread(buffer.data() + carried, 1, buffer.size() - carried, file);
+                if (read == 0 && std::ferror(file))
+                    return false;
+                done = read == 0;
+
+                const sizeType size = carried + read;
+                sizeType end = size;
+                if (!done)
+                {
+                    while (end > 0 && buffer[end - 1] != '\n')
+                        end--;
+                    if (end == 0)
+                    {
+                        carried = size;
+                        continue;
+                    }
+                }
+
+                if (!parse(buffer.data(), end, format, slices))
+                    return false;
+                for (auto & s : slices)
+                    consume(s);
+
+                carried = size - end;
+                std::copy(buffer.begin() + end, buffer.begin() + size, buffer.begin());
+            }
+            return true;
+        }
+
+        /// @brief Dzieli paczke na fragmenty konczace sie na granicach wierszy i parsuje je rownolegle.
+        /// @return Zwraca falsz, jezeli ktorykolwiek wiersz jest niepoprawny.
+        bool parse(const char* data, const sizeType& size, const GraphFormat& format, std::vector<Slice>& slices)
+        {
+            std::vector<sizeType> bounds(slices.size() + 1, size);
+            bounds[0] = 0;
+            for (sizeType s = 1; s < slices.size(); s++)
+            {
+                sizeType b = std::max(bounds[s - 1], size * s / slices.size());
+                while (b < size && b > 0 && data[b - 1] != '\n')
+                    b++;
+                bounds[s] = b;
+            }
+
+            pool->parallelFor(slices.size(), [&](sizeType, sizeType s)
+            {
+                Slice& slice = slices[s];
+                slice.arcs.clear();
+                slice.declared = 0;
+                slice.valid = true;
+                const char* p = data + bounds[s];
+                const char* end = data + bounds[s + 1];
+                while (p < end && slice.valid)
+                {
+                    const char* line = p;
+                    while (p < end && *p != '\n')
+                        p++;
+                    slice.valid = format == GraphFormat::DIMACS ? parseDimacs(line, p, slice) : parseSnap(line, p, slice);
+                    p++;
+                }
+            });
+
+            for (auto & s : slices)
+                if (!s.valid)
+                    return false;
+            return true;
+        }
+
+        /// @brief Parsuje jeden wiersz DIMACS [p, end).
+        static bool parseDimacs(const char* p, const char* end, Slice& slice)
+        {
+            skipSpaces(p, end);
+            if (p == end || *p == 'c')
+                return true;
+            const char kind = *p++;
+            std::uint64_t u, v, w;
+            if (kind == 'p')
+            {
+                skipSpaces(p, end);
+                while (p < end && *p != ' ' && *p != '\t')
+                    p++;
+                if (!parseNumber(p, end, v) || !parseNumber(p, end, w) || !finished(p, end) || v == 0 || v >= UINT32_MAX)
+                    return false;
+                slice.declared = v;
+                return true;
+            }
+            if (kind != 'a' || !parseNumber(p, end, u) || !parseNumber(p, end, v) || !parseNumber(p, end, w) || !finished(p, end))
+                return false;
+            if (u == 0 || v == 0 || u > UINT32_MAX - 1 || v > UINT32_MAX - 1 || w > INT_MAX)
+                return false;
+            slice.arcs.push_back({ static_cast<std::uint32_t>(u - 1), static_cast<std::uint32_t>(v - 1), static_cast<int>(w) });
+            return true;
+        }
+
+        /// @brief Parsuje jeden wiersz SNAP [p, end).
+        static bool parseSnap(const char* p, const char* end, Slice& slice)
+        {
+            skipSpaces(p, end);
+            if (p == end || *p == '#' || *p == '%')
+                return true;
+            std::uint64_t u, v, w = 1;
+            if (!parseNumber(p, end, u) || !parseNumber(p, end, v))
+                return false;
+            skipSpaces(p, end);
+            if (p < end && !parseNumber(p, end, w))
+                return false;
+            if (!finished(p, end) || u >= UINT32_MAX - 1 || v >= UINT32_MAX - 1 || w > INT_MAX)
+                return false;
+            slice.arcs.push_back({ static_cast<std::uint32_t>(u), static_cast<std::uint32_t>(v), static_cast<int>(w) });
+            return true;
+        }
+
+        static void skipSpaces(const char*& p, const char* end)
+        {
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+                p++;
+        }
+
+        /// @return Zwraca prawde, jezeli do konca wiersza pozostaly tylko biale znaki.
+        static bool finished(const char*& p, const char* end)
+        {
+            skipSpaces(p, end);
+            return p == end;
+        }
+
+        /// @brief Parsuje liczbe naturalna poprzedzona bialymi znakami.
+        /// @return Zwraca falsz, jezeli brak cyfr albo liczba nie miesci sie w 64 bitach.
+        static bool parseNumber(const char*& p, const char* end, std::uint64_t& value)
+        {
+            skipSpaces(p, end);
+            if (p == end || *p < '0' || *p > '9')
+                return false;
+            value = 0;
+            for (; p < end && *p >= '0' && *p <= '9'; p++)
+            {
+                if (value > (UINT64_MAX - 9) / 10)
+                    return false;
+                value = 10 * value + static_cast<std::uint64_t>(*p - '0');
+            }
+            return true;
+        }
+
+        std::unique_ptr<ThreadPool> ownedPool;
+        ThreadPool* pool;
+        sizeType chunkSize;
+};
+
+#endif
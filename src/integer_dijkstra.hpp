@@ -0,0 +1,296 @@
+#ifndef INTEGER_DIJKSTRA_HPP
+#define INTEGER_DIJKSTRA_HPP
+
+#include <array>
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <type_traits>
+
+#include "graph.hpp"
+#include "csr_graph.hpp"
+#include "algorithm_stats.hpp"
+#include "trace.hpp"
+
+/// @brief Monotoniczna kolejka kubelkowa Diala. Klucz kazdego wstawianego elementu lezy w przedziale
+/// [ostatnio zdjety klucz, ostatnio zdjety klucz + C], wiec wystarcza cykliczna tablica kubelkow o rozmiarze
+/// potegi dwojki nie mniejszej niz C + 1. Wstawienie kosztuje O(1), a wszystkie zdjecia lacznie O(n + max klucz).
+/// Kolejka nie zmniejsza kluczy: ponowne wstawienie wierzcholka zostawia przestarzaly wpis, pomijany przez algorytm.
+/// @tparam C najwieksza waga krawedzi
+template <std::uint64_t C>
+class DialQueue
+{
+    public:
+        /// @return Zwraca prawde, jezeli kolejka jest pusta.
+        bool empty() const
+            { return count == 0; }
+
+        /// @brief Wstawia wierzcholek o danym kluczu.
+        /// @param x indeks wierzcholka
+        /// @param key klucz z przedzialu [ostatnio zdjety klucz, ostatnio zdjety klucz + C]
+        void push(const std::uint32_t& x, const std::uint64_t& key)
+        {
+            buckets[key & MASK].push_back(x);
+            ++count;
+        }
+
+        /// @brief Zdejmuje wierzcholek o najmniejszym kluczu.
+        /// @param key otrzymuje klucz zdjetego wierzcholka
+        /// @return Zwraca indeks wierzcholka.
+        std::uint32_t pop(std::uint64_t& key)
+        {
+            while (buckets[current & MASK].empty())
+                ++current;
+            std::vector<std::uint32_t>& bucket = buckets[current & MASK];
+            const std::uint32_t x = bucket.back();
+            bucket.pop_back();
+            --count;
+            key = current;
+            return x;
+        }
+
+    private:
+        static constexpr std::uint64_t size()
+        {
+            std::uint64_t s = 1;
+            while (s < C + 1)
+                s <<= 1;
+            return s;
+        }
+
+        static constexpr std::uint64_t MASK = size() - 1;
+
+        std::vector<std::vector<std::uint32_t>> buckets = std::vector<std::vector<std::uint32_t>>(size());
+        std::uint64_t current = 0;
+        sizeType count = 0;
+};
+
+/// @brief Monotoniczny kopiec pozycyjny (radix heap) dla 64-bitowych kluczy. Element trafia do kubelka
+/// wyznaczonego przez najstarszy bit, na ktorym jego klucz rozni sie od ostatnio zdjetego, wiec kazdy element
+/// przenoszony jest do nizszego kubelka co najwyzej 64 razy, niezaleznie od wag krawedzi.
+/// Kolejka nie zmniejsza kluczy: ponowne wstawienie wierzcholka zostawia przestarzaly wpis, pomijany przez algorytm.
+class RadixHeap
+{
+    public:
+        /// @return Zwraca prawde, jezeli kolejka jest pusta.
+        bool empty() const
+            { return count == 0; }
+
+        /// @brief Wstawia wierzcholek o danym kluczu.
+        /// @param x indeks wierzcholka
+        /// @param key klucz nie mniejszy niz ostatnio zdjety
+        void push(const std::uint32_t& x, const std::uint64_t& key)
+        {
+            buckets[bucket(key)].push_back({ key, x });
+            ++count;
+        }
+
+        /// @brief Zdejmuje wierzcholek o najmniejszym kluczu.
+        /// @param key otrzymuje klucz zdjetego wierzcholka
+        /// @return Zwraca indeks wierzcholka.
+        std::uint32_t pop(std::uint64_t& key)
+        {
+            if (buckets[0].empty())
+            {
+                // Najnizszy niepusty kubelek otrzymuje nowe minimum, a jego elementy rozchodza sie do nizszych kubelkow
+                sizeType i = 1;
+                while (buckets[i].empty())
+                    ++i;
+                std::uint64_t minimum = buckets[i].front().key;
+                for (auto & e : buckets[i])
+                    if (e.key < minimum)
+                        minimum = e.key;
+                last = minimum;
+                for (auto & e : buckets[i])
+                    buckets[bucket(e.key)].push_back(e);
+                buckets[i].clear();
+            }
+            const Entry e = buckets[0].back();
+            buckets[0].pop_back();
+            --count;
+            key = e.key;
+            return e.vertex;
+        }
+
+    private:
+        struct Entry
+        {
+            std::uint64_t key;
+            std::uint32_t vertex;
+        };
+
+        /// @return Zwraca 0 dla klucza rownego ostatnio zdjetemu, a w przeciwnym razie numer najstarszego
+        /// bitu roznicy powiekszony o 1.
+        sizeType bucket(const std::uint64_t& key) const
+        {
+            const std::uint64_t difference = key ^ last;
+            if (difference == 0)
+                return 0;
+#if defined(__GNUC__)
+            return 64 - __builtin_clzll(difference);
+#else
+            sizeType bits = 0;
+            for (std::uint64_t d = difference; d; d >>= 1)
+                ++bits;
+            return bits;
+#endif
+        }
+
+        std::array<std::vector<Entry>, 65> buckets;
+        std::uint64_t last = 0;
+        sizeType count = 0;
+};
+
+/// @brief Algorytm Dijkstry dla nieujemnych calkowitych wag krawedzi z monotoniczna kolejka calkowitoliczbowa
+/// zamiast kopca porownujacego klucze. Odleglosci sa 64-bitowe, wiec suma wag 32-bitowych nie moze sie przepelnic.
+/// Kolejka wybierana jest w czasie kompilacji na podstawie ograniczenia wag: kubelki Diala, gdy najwieksza waga
+/// nie przekracza DIAL_LIMIT, a w przeciwnym razie kopiec pozycyjny. Ograniczeniem jest podpowiedz MaxWeight,
+/// a przy jej braku zakres typu wagi (np. std::uint8_t wybiera kubelki Diala).
+class IntegerDijkstraAlgorithm
+{
+    public:
+        IntegerDijkstraAlgorithm() = delete;
+
+        /// @brief Odleglosc wierzcholkow nieosiagalnych.
+        static constexpr std::uint64_t INF = std::numeric_limits<std::uint64_t>::max();
+
+        /// @brief Najwieksze ograniczenie wag, dla ktorego wybierane sa kubelki Diala.
+        static constexpr std::uint64_t DIAL_LIMIT = 1 << 12;
+
+        /// @brief Kolejka wybrana dla typu wagi W i podpowiedzi MaxWeight.
+        /// @tparam W calkowity typ danych na krawedziach grafu
+        /// @tparam MaxWeight najwieksza waga krawedzi w grafie (0 - zakres typu W)
+        template <typename W, std::uint64_t MaxWeight>
+        struct Queue
+        {
+            static_assert(std::is_integral<W>::value, "wagi krawedzi musza byc calkowite");
+            static_assert(sizeof(W) <= 4, "suma wag 64-bitowych moglaby przepelnic odleglosc");
+
+            static constexpr std::uint64_t bound = MaxWeight ? MaxWeight : static_cast<std::uint64_t>(std::numeric_limits<W>::max());
+            static constexpr bool dial = bound <= DIAL_LIMIT;
+            typedef typename std::conditional<dial, DialQueue<bound>, RadixHeap>::type type;
+        };
+
+        /// @brief Algorytm Dijkstry z kolejka calkowitoliczbowa.
+        /// @tparam MaxWeight najwieksza waga krawedzi w grafie (0 - zakres typu W); wieksza waga daje bledny wynik
+        /// @tparam T typ elementow na wierzcholkach
+        /// @tparam W calkowity typ danych na krawedziach grafu
+        /// @param graph referencja do nieskierowanego grafu prostego z nieujemnymi wagami krawedzi
+        /// @param v referencja do wierzcholka wejsciowego
+        /// @return Zwraca dlugosci sciezek do kazdego wierzcholka w grafie (INF dla nieosiagalnych).
+        template <std::uint64_t MaxWeight = 0, typename T, typename W>
+        static std::vector<std::uint64_t> shortestPath(const GraphADT<T,W>* graph, const Vertex<T,W>* v)
+        {
+            NoStats stats;
+            return shortestPath<MaxWeight>(graph, v, stats);
+        }
+
+        /// @brief Algorytm Dijkstry z kolejka calkowitoliczbowa, zliczajacy wykonane operacje.
+        /// @tparam MaxWeight najwieksza waga krawedzi w grafie (0 - zakres typu W); wieksza waga daje bledny wynik
+        /// @tparam T typ elementow na wierzcholkach
+        /// @tparam W calkowity typ danych na krawedziach grafu
+        /// @tparam S polityka statystyk (NoStats, CountingStats)
+        /// @param graph referencja do nieskierowanego grafu prostego z nieujemnymi wagami krawedzi
+        /// @param v referencja do wierzcholka wejsciowego
+        /// @param stats statystyki, do ktorych dopisywane sa operacje algorytmu
+        /// @return Zwraca dlugosci sciezek do kazdego wierzcholka w grafie (INF dla nieosiagalnych).
+        template <std::uint64_t MaxWeight = 0, typename T, typename W, typename S>
+        static std::vector<std::uint64_t> shortestPath(const GraphADT<T,W>* graph, const Vertex<T,W>* v, S& stats)
+        {
+            TRACE_SPAN("IntegerDijkstraAlgorithm::shortestPath");
+            std::vector<std::uint64_t> D(graph->sizeV(), INF);
+            typename Queue<W, MaxWeight>::type queue;
+            run(D, v->i, queue, stats, [&](const sizeType& u, const std::uint64_t& du, auto relax)
+            {
+                const Vertex<T,W>* vu = graph->vertex(u);
+                for (auto e : graph->incidentEdgesRange(vu))
+                    relax(graph->opposite(vu, e)->i, du + static_cast<std::uint64_t>(e->element));
+            });
+            return D;
+        }
+
+        /// @brief Algorytm Dijkstry z kolejka calkowitoliczbowa dla grafu w formacie CSR.
+        /// @tparam MaxWeight najwieksza waga krawedzi w grafie (0 - zakres typu W); wieksza waga daje bledny wynik
+        /// @tparam W calkowity typ danych na krawedziach grafu
+        /// @param graph graf w formacie CSR z nieujemnymi wagami krawedzi
+        /// @param v indeks wierzcholka wejsciowego
+        /// @return Zwraca dlugosci sciezek do kazdego wierzcholka w grafie (INF dla nieosiagalnych).
+        template <std::uint64_t MaxWeight = 0, typename W>
+        static std::vector<std::uint64_t> shortestPath(const CSRView<W>& graph, const sizeType& v)
+        {
+            NoStats stats;
+            return shortestPath<MaxWeight>(graph, v, stats);
+        }
+
+        /// @brief Algorytm Dijkstry z kolejka calkowitoliczbowa dla grafu w formacie CSR, zliczajacy wykonane operacje.
+        /// @tparam MaxWeight najwieksza waga krawedzi w grafie (0 - zakres typu W); wieksza waga daje bledny wynik
+        /// @tparam W calkowity typ danych na krawedziach grafu
+        /// @tparam S polityka statystyk (NoStats, CountingStats)
+        /// @param graph graf w formacie CSR z nieujemnymi wagami krawedzi
+        /// @param v indeks wierzcholka wejsciowego
+        /// @param stats statystyki, do ktorych dopisywane sa operacje algorytmu
+        /// @return Zwraca dlugosci sciezek do kazdego wierzcholka w grafie (INF dla nieosiagalnych).
+        template <std::uint64_t MaxWeight = 0, typename W, typename S>
+        static std::vector<std::uint64_t> shortestPath(const CSRView<W>& graph, const sizeType& v, S& stats)
+        {
+            TRACE_SPAN("IntegerDijkstraAlgorithm::shortestPath(CSR)");
+            std::vector<std::uint64_t> D(graph.sizeV(), INF);
+            typename Queue<W, MaxWeight>::type queue;
+            run(D, v, queue, stats, [&](const sizeType& u, const std::uint64_t& du, auto relax)
+            {
+                for (sizeType k = graph.offset(u); k < graph.offset(u + 1); k++)
+                    relax(graph.target(k), du + static_cast<std::uint64_t>(graph.weight(k)));
+            });
+            return D;
+        }
+
+        /// @brief Wersja dla migawki CSRGraph, dla ktorej typ wag nie jest wyprowadzany przez konwersje do widoku.
+        template <std::uint64_t MaxWeight = 0, typename W>
+        static std::vector<std::uint64_t> shortestPath(const CSRGraph<W>& graph, const sizeType& v)
+            { return shortestPath<MaxWeight>(graph.view(), v); }
+
+        /// @brief Wersja dla migawki CSRGraph, zliczajaca wykonane operacje.
+        template <std::uint64_t MaxWeight = 0, typename W, typename S>
+        static std::vector<std::uint64_t> shortestPath(const CSRGraph<W>& graph, const sizeType& v, S& stats)
+            { return shortestPath<MaxWeight>(graph.view(), v, stats); }
+
+    private:
+        /// @brief Petla glowna wspolna dla reprezentacji grafu. Wierzcholek zdjety z kluczem wiekszym niz jego
+        /// odleglosc jest przestarzalym wpisem i zostaje pominiety.
+        /// @param neighbours funkcja (u, D[u], relax) wywolujaca relax(z, D[u] + waga) dla kazdego sasiada z
+        template <typename Q, typename S, typename F>
+        static void run(std::vector<std::uint64_t>& D, const sizeType& source, Q& queue, S& stats, const F& neighbours)
+        {
+            D[source] = 0;
+            queue.push(static_cast<std::uint32_t>(source), 0);
+            stats.push();
+
+            auto relax = [&](const sizeType& z, const std::uint64_t& dz)
+            {
+                stats.relaxAttempt();
+                if (dz < D[z])
+                {
+                    D[z] = dz;
+                    queue.push(static_cast<std::uint32_t>(z), dz);
+                    stats.relaxSuccess();
+                    stats.push();
+                }
+            };
+
+            while (!queue.empty())
+            {
+                std::uint64_t du;
+                const std::uint32_t u = queue.pop(du);
+                stats.pop();
+                if (du != D[u])
+                {
+                    stats.stalePop();
+                    continue;
+                }
+                stats.incidentEdges();
+                neighbours(u, du, relax);
+            }
+        }
+};
+
+#endif
@@ -1,24 +1,66 @@
 #include <iostream>
 #include <chrono>
+#include <cstdlib>
 
 #include "data_manager.hpp"
 #include "adjacency_list_graph.hpp"
 #include "adjacency_matrix_graph.hpp"
 #include "dijkstra_algorithm.hpp"
+#include "integer_dijkstra.hpp"
+#include "benchmark.hpp"
 
 int main()
 {
-    const int N[5] { 10, 50, 100, 500, 1000 };
-    const double D[4] { .25, .5, .75, 1 };
+    // Sledzenie wlaczane zmienna srodowiskowa GRAPH_TRACE=plik.json, zapis przy zakonczeniu programu
+    if (const char* tracePath = std::getenv("GRAPH_TRACE"))
+        Tracer::start(tracePath);
 
-    AdjacencyListGraph<int,int> ALgraph;
-    AdjacencyMatrixGraph<int,int> AMgraph;
-    
-    auto ALtab = DataManager::createTimesTable(&ALgraph, N, 5, D, 4);
-    DataManager::saveToCSV("../AL_data.csv", ALtab, 5, 6, ';');
+    BenchmarkConfig config;
+    config.verticesNumbers = { 10, 50, 100, 500, 1000 };
+    config.densities = { .25, .5, .75, 1 };
+    config.warmup = 5;
+    config.repetitions = 100;
+    config.queriesPerGraph = 5;
+    config.threads = 1;
+    config.counters = true;
+    config.workStats = true;
 
-    auto AMtab = DataManager::createTimesTable(&AMgraph, N, 5, D, 4);
-    DataManager::saveToCSV("../AM_data.csv", AMtab, 5, 6, ';');
+    // Rownolegle proby na GRAPH_THREADS watkach (0 - liczba rdzeni); domyslnie pomiary sa szeregowe,
+    // aby watki nie dzielily pamieci podrecznej, przepustowosci pamieci ani zegara turbo
+    if (const char* threads = std::getenv("GRAPH_THREADS"))
+        config.threads = std::strtoul(threads, nullptr, 10);
+
+    // Graf rzeczywisty zamiast siatki grafow losowych: GRAPH_INPUT=plik.gr (DIMACS) albo lista krawedzi SNAP
+    if (const char* inputPath = std::getenv("GRAPH_INPUT"))
+        config.inputPath = inputPath;
+
+    auto makeList = [] { return std::unique_ptr<GraphADT<int,int>>(new AdjacencyListGraph<int,int>()); };
+    auto makeMatrix = [] { return std::unique_ptr<GraphADT<int,int>>(new AdjacencyMatrixGraph<int,int>()); };
+    auto dijkstra = [] { return std::unique_ptr<BenchmarkQuery>(new SingleSourceQuery("Dijkstra", DijkstraAlgorithm::shortestPath<BinaryHeap,int>,
+                                                                                               DijkstraAlgorithm::shortestPath<BinaryHeap,int,CountingStats>)); };
+    auto integerDijkstra = [] { return std::unique_ptr<BenchmarkQuery>(new BasicSingleSourceQuery<std::uint64_t>("IntegerDijkstra", IntegerDijkstraAlgorithm::shortestPath<0,int,int>,
+                                                                                                                 IntegerDijkstraAlgorithm::shortestPath<0,int,int,CountingStats>)); };
+    auto denseDijkstra = [] { return std::unique_ptr<BenchmarkQuery>(new SingleSourceQuery("DenseDijkstra", DenseDijkstraAlgorithm::shortestPath<int>)); };
+    auto bidirectional = [] { return std::unique_ptr<BenchmarkQuery>(new PointToPointQuery()); };
+    auto alt = [] { return std::unique_ptr<BenchmarkQuery>(new LandmarkQuery()); };
+    auto hierarchy = [] { return std::unique_ptr<BenchmarkQuery>(new HierarchyQuery()); };
+    auto repair = [] { return std::unique_ptr<BenchmarkQuery>(new EdgeUpdateQuery("DynamicRepair", true)); };
+    auto recompute = [] { return std::unique_ptr<BenchmarkQuery>(new EdgeUpdateQuery("DynamicRecompute", false)); };
+
+    Benchmark benchmark(config);
+    benchmark.run("AdjacencyList", makeList, dijkstra);
+    benchmark.run("AdjacencyMatrix", makeMatrix, dijkstra);
+    benchmark.run("AdjacencyList", makeList, integerDijkstra);
+    benchmark.run("AdjacencyMatrix", makeMatrix, denseDijkstra);
+    benchmark.run("AdjacencyList", makeList, bidirectional);
+    benchmark.run("AdjacencyMatrix", makeMatrix, bidirectional);
+    benchmark.run("AdjacencyList", makeList, alt);
+    benchmark.run("AdjacencyList", makeList, hierarchy);
+    benchmark.run("AdjacencyList", makeList, repair);
+    benchmark.run("AdjacencyList", makeList, recompute);
+
+    benchmark.saveToCSV("../results.csv", ';');
+    benchmark.saveToJSON("../results.json");
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,367 @@
+#ifndef MAPPED_GRAPH_HPP
+#define MAPPED_GRAPH_HPP
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "graph.hpp"
+#include "csr_graph.hpp"
+#include "weight_traits.hpp"
+#include "trace.hpp"
+
+/// @brief Graf w binarnym formacie CSR, odwzorowany w pamieci tylko do odczytu.
+/// Plik sklada sie z naglowka i sekcji wyrownanych do 64 bajtow: przesuniec (u64, sizeV() + 1), indeksow sasiadow
+/// (u32, sizeE()), wag (W, sizeE()) i opcjonalnie elementow wierzcholkow (T, sizeV()). Wczytanie sprawdza tylko
+/// naglowek i granice sekcji, a tablice sa udostepniane bezposrednio z odwzorowanego pliku bez kopiowania,
+/// wiec czas otwarcia nie zalezy od rozmiaru grafu. Strony sa doczytywane przez system przy pierwszym dostepie.
+/// Pelna kontrola zawartosci jest dostepna osobno przez validate(). Format uzywa natywnej kolejnosci bajtow.
+/// @tparam T typ elementow na wierzcholkach (zapisywanych, jezeli jest trywialnie kopiowalny)
+/// @tparam W typ danych na krawedziach grafu (trywialnie kopiowalny)
+template <typename T, typename W>
+class MappedGraph
+{
+    static_assert(std::is_trivially_copyable<W>::value, "wagi musza byc trywialnie kopiowalne");
+    static_assert(sizeof(sizeType) == sizeof(std::uint64_t), "przesuniecia sa odwzorowywane jako 64-bitowe");
+
+    public:
+        /// @brief Czy elementy wierzcholkow typu T moga byc zapisane w pliku.
+        static constexpr bool storesPayloads = std::is_trivially_copyable<T>::value;
+
+        MappedGraph() = default;
+
+        MappedGraph(const MappedGraph&) = delete;
+        MappedGraph& operator=(const MappedGraph&) = delete;
+
+        MappedGraph(MappedGraph&& other) noexcept
+            { *this = std::move(other); }
+
+        MappedGraph& operator=(MappedGraph&& other) noexcept
+        {
+            if (this != &other)
+            {
+                close();
+                data = other.data;
+                length = other.length;
+                buffer = std::move(other.buffer);
+                header = other.header;
+                other.data = nullptr;
+                other.length = 0;
+                other.header = Header();
+            }
+            return *this;
+        }
+
+        ~MappedGraph()
+            { close(); }
+
+        /// @brief Zapisuje graf do pliku binarnego.
+        /// @param graph referencja do grafu
+        /// @param filePath sciezka do pliku
+        /// @param payloads czy zapisac elementy wierzcholkow (pomijane, jezeli T nie jest trywialnie kopiowalny)
+        /// @return Zwraca falsz, jezeli zapis sie nie powiodl.
+        static bool save(const GraphADT<T,W>* graph, const std::string& filePath, const bool& payloads = true)
+        {
+            TRACE_SPAN("MappedGraph::save");
+            std::vector<T> elements;
+            if constexpr (storesPayloads)
+            {
+                if (payloads)
+                {
+                    elements.reserve(graph->sizeV());
+                    for (sizeType i = 0; i < graph->sizeV(); i++)
+                        elements.push_back(graph->vertex(i)->element);
+                }
+            }
+            return write(graph->freeze(), elements.empty() ? nullptr : elements.data(), filePath);
+        }
+
+        /// @brief Zapisuje migawke CSR do pliku binarnego, bez elementow wierzcholkow.
+        /// @param graph migawka grafu
+        /// @param filePath sciezka do pliku
+        /// @return Zwraca falsz, jezeli zapis sie nie powiodl.
+        static bool save(const CSRView<W>& graph, const std::string& filePath)
+            { return write(graph, nullptr, filePath); }
+
+        /// @brief Odwzorowuje plik zapisany przez save() w pamieci. Poprzednio otwarty plik jest zamykany.
+        /// @param filePath sciezka do pliku
+        /// @return Zwraca falsz, jezeli plik nie istnieje, ma inna wersje, inny typ wag lub elementow albo jest obciety.
+        bool open(const std::string& filePath)
+        {
+            TRACE_SPAN("MappedGraph::open");
+            close();
+            if (!map(filePath) || !accept())
+            {
+                close();
+                return false;
+            }
+            return true;
+        }
+
+        /// @brief Zwalnia odwzorowanie; wczesniej zwrocone widoki staja sie niewazne.
+        void close()
+        {
+#if defined(__linux__)
+            if (data)
+                munmap(const_cast<char*>(data), length);
+#endif
+            data = nullptr;
+            length = 0;
+            buffer.clear();
+            buffer.shrink_to_fit();
+            header = Header();
+        }
+
+        /// @return Zwraca prawde, jezeli plik jest otwarty.
+        bool isOpen() const
+            { return data != nullptr; }
+
+        /// @return Zwraca liczbe wierzcholkow.
+        sizeType sizeV() const
+            { return header.vertices; }
+
+        /// @return Zwraca liczbe wpisow w tablicy sasiadow (dwukrotnosc liczby krawedzi nieskierowanych).
+        sizeType sizeE() const
+            { return header.entries; }
+
+        /// @return Zwraca widok CSR na odwzorowane tablice, wazny do zamkniecia pliku.
+        CSRView<W> view() const
+        {
+            if (!data)
+                return CSRView<W>();
+            return CSRView<W>(header.vertices, section<sizeType>(header.offsets), section<std::uint32_t>(header.targets),
+                              section<W>(header.weights));
+        }
+
+        /// @brief Niejawna konwersja pozwalajaca przekazac graf do algorytmow przyjmujacych widok.
+        operator CSRView<W>() const
+            { return view(); }
+
+        /// @return Zwraca prawde, jezeli plik zawiera elementy wierzcholkow.
+        bool hasPayloads() const
+            { return header.payloads != 0; }
+
+        /// @param i indeks wierzcholka
+        /// @return Zwraca element wierzcholka zapisany w pliku (wymaga hasPayloads()).
+        const T& payload(const sizeType& i) const
+            { return section<T>(header.payloads)[i]; }
+
+        /// @brief Sprawdza spojnosc calej zawartosci: rosnace przesuniecia i poprawne indeksy sasiadow.
+        /// Czyta wszystkie strony pliku, wiec jest kosztowne dla duzych grafow.
+        /// @return Zwraca prawde, jezeli graf jest poprawny.
+        bool validate() const
+        {
+            if (!data)
+                return false;
+            const CSRView<W> g = view();
+            for (sizeType v = 0; v < g.sizeV(); v++)
+                if (g.offset(v) > g.offset(v + 1))
+                    return false;
+            for (sizeType k = 0; k < g.sizeE(); k++)
+                if (g.target(k) >= g.sizeV())
+                    return false;
+            return true;
+        }
+
+    private:
+        static constexpr char MAGIC[8] = { 'G', 'C', 'S', 'R', 'M', 'A', 'P', 0 };
+        static constexpr std::uint32_t VERSION = 2;
+        static constexpr std::uint32_t ENDIAN = 0x01020304;
+        static constexpr std::uint64_t ALIGNMENT = 64;
+
+        /// @brief Naglowek pliku; polozenia sekcji sa bezwzglednymi przesunieciami od poczatku pliku.
+        struct Header
+        {
+            char magic[8] = {};
+            std::uint32_t version = 0;
+            std::uint32_t endian = 0;
+            std::uint32_t weightSize = 0;
+            std::uint32_t payloadSize = 0;
+            std::uint64_t vertices = 0;
+            std::uint64_t entries = 0;
+            std::uint64_t offsets = 0;
+            std::uint64_t targets = 0;
+            std::uint64_t weights = 0;
+            std::uint64_t payloads = 0;
+            std::uint64_t fileSize = 0;
+            std::uint32_t weightType = 0;
+            char reserved[44] = {};
+        };
+        static_assert(sizeof(Header) == 2 * ALIGNMENT, "naglowek zajmuje dwa bloki wyrownania");
+
+        /// @return Zwraca rodzaj typu wag zapisywany obok jego rozmiaru, aby np. int i float nie byly mylone:
+        /// 1 - calkowity ze znakiem, 2 - calkowity bez znaku, 3 - zmiennopozycyjny, 4 - stalopozycyjny, 5 - inny.
+        static constexpr std::uint32_t weightKind()
+        {
+            if constexpr (std::is_integral<W>::value)
+                return std::is_signed<W>::value ? 1 : 2;
+            else if constexpr (std::is_floating_point<W>::value)
+                return 3;
+            else if constexpr (IsFixedPoint<W>::value)
+                return 4;
+            else
+                return 5;
+        }
+
+        static std::uint64_t align(const std::uint64_t& position)
+            { return (position + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT; }
+
+        static bool write(const CSRView<W>& graph, const T* elements, const std::string& filePath)
+        {
+            const sizeType n = graph.sizeV();
+            const sizeType m = graph.sizeE();
+
+            Header h;
+            std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+            h.version = VERSION;
+            h.endian = ENDIAN;
+            h.weightSize = sizeof(W);
+            h.weightType = weightKind();
+            h.payloadSize = storesPayloads ? sizeof(T) : 0;
+            h.vertices = n;
+            h.entries = m;
+            h.offsets = sizeof(Header);
+            h.targets = align(h.offsets + 8 * (n + 1));
+            h.weights = align(h.targets + 4 * m);
+            h.payloads = elements ? align(h.weights + sizeof(W) * m) : 0;
+            h.fileSize = elements ? h.payloads + sizeof(T) * n : h.weights + sizeof(W) * m;
+
+            std::ofstream output(filePath, std::ios::binary);
+            output.write(reinterpret_cast<const char*>(&h), sizeof(h));
+            std::vector<std::uint64_t> offsets(n + 1);
+            for (sizeType v = 0; v <= n; v++)
+                offsets[v] = n ? graph.offset(v) : 0;
+            pad(output, h.offsets);
+            output.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * 8);
+            pad(output, h.targets);
+            writeChunked<std::uint32_t>(output, m, [&](const sizeType& k) { return graph.target(k); });
+            pad(output, h.weights);
+            writeChunked<W>(output, m, [&](const sizeType& k) { return graph.weight(k); });
+            if (elements)
+            {
+                pad(output, h.payloads);
+                output.write(reinterpret_cast<const char*>(elements), n * sizeof(T));
+            }
+            return static_cast<bool>(output);
+        }
+
+        /// @brief Zapisuje count wartosci get(k) paczkami, bez kopiowania calej tablicy.
+        template <typename X, typename F>
+        static void writeChunked(std::ofstream& output, const sizeType& count, F get)
+        {
+            constexpr sizeType CHUNK = 1 << 16;
+            std::vector<X> chunk;
+            chunk.reserve(CHUNK);
+            for (sizeType k = 0; k < count && output; k++)
+            {
+                chunk.push_back(get(k));
+                if (chunk.size() == CHUNK || k + 1 == count)
+                {
+                    output.write(reinterpret_cast<const char*>(chunk.data()), chunk.size() * sizeof(X));
+                    chunk.clear();
+                }
+            }
+        }
+
+        /// @brief Dopisuje zera do wskazanej pozycji w pliku.
+        static void pad(std::ofstream& output, const std::uint64_t& position)
+        {
+            static const char zeros[ALIGNMENT] = {};
+            const std::uint64_t current = static_cast<std::uint64_t>(output.tellp());
+            if (output && current < position)
+                output.write(zeros, position - current);
+        }
+
+        /// @brief Odwzorowuje plik w pamieci (poza Linuksem wczytuje go do bufora).
+        bool map(const std::string& filePath)
+        {
+#if defined(__linux__)
+            const int fd = ::open(filePath.c_str(), O_RDONLY);
+            if (fd < 0)
+                return false;
+            struct stat info;
+            if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(Header)))
+            {
+                ::close(fd);
+                return false;
+            }
+            void* address = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (address == MAP_FAILED)
+                return false;
+            data = static_cast<const char*>(address);
+            length = info.st_size;
+            return true;
+#else
+            std::ifstream input(filePath, std::ios::binary | std::ios::ate);
+            if (!input)
+                return false;
+            const std::streamoff size = input.tellg();
+            if (size < static_cast<std::streamoff>(sizeof(Header)))
+                return false;
+            buffer.resize((size + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+            input.seekg(0);
+            if (!input.read(reinterpret_cast<char*>(buffer.data()), size))
+                return false;
+            data = reinterpret_cast<const char*>(buffer.data());
+            length = size;
+            return true;
+#endif
+        }
+
+        /// @brief Sprawdza naglowek i granice sekcji odwzorowanego pliku. Nie czyta tablic poza pierwszym
+        /// i ostatnim przesunieciem, aby otwarcie nie wymagalo wczytania calego pliku.
+        bool accept()
+        {
+            Header h;
+            std::memcpy(&h, data, sizeof(h));
+            if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0 || h.version != VERSION || h.endian != ENDIAN ||
+                h.weightSize != sizeof(W) || h.weightType != weightKind() || h.fileSize != length || h.vertices >= UINT32_MAX ||
+                h.entries > length)
+                return false;
+            if (h.payloads && h.payloadSize != (storesPayloads ? sizeof(T) : 0))
+                return false;
+
+            const std::uint64_t n = h.vertices;
+            const std::uint64_t m = h.entries;
+            if (!fits(h.offsets, 8 * (n + 1), sizeof(Header)) || !fits(h.targets, 4 * m, h.offsets + 8 * (n + 1)) ||
+                !fits(h.weights, sizeof(W) * m, h.targets + 4 * m) ||
+                (h.payloads && !fits(h.payloads, sizeof(T) * n, h.weights + sizeof(W) * m)))
+                return false;
+
+            header = h;
+            const sizeType* offsets = section<sizeType>(header.offsets);
+            if (offsets[0] != 0 || offsets[n] != m)
+            {
+                header = Header();
+                return false;
+            }
+            return true;
+        }
+
+        /// @return Zwraca prawde, jezeli wyrownana sekcja o danym rozmiarze zaczyna sie nie wczesniej niz begin
+        /// i miesci sie w pliku.
+        bool fits(const std::uint64_t& position, const std::uint64_t& size, const std::uint64_t& begin) const
+            { return position % ALIGNMENT == 0 && position >= begin && position <= length && size <= length - position; }
+
+        template <typename X>
+        const X* section(const std::uint64_t& position) const
+            { return reinterpret_cast<const X*>(data + position); }
+
+        const char* data = nullptr;
+        sizeType length = 0;
+        std::vector<std::uint64_t> buffer;
+        Header header;
+};
+
+#endif
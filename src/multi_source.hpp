@@ -0,0 +1,166 @@
+#ifndef MULTI_SOURCE_HPP
+#define MULTI_SOURCE_HPP
+
+#include <vector>
+#include <memory>
+#include <functional>
+
+#include "graph.hpp"
+#include "csr_graph.hpp"
+#include "priority_queue.hpp"
+#include "dijkstra_algorithm.hpp"
+#include "thread_pool.hpp"
+#include "trace.hpp"
+
+/// @brief Rownolegle wyznaczanie najkrotszych sciezek z wielu wierzcholkow zrodlowych tego samego grafu.
+/// Zrodla rozdzielane sa miedzy watki puli z podkradaniem pracy, a kazdy watek uzywa wlasnej przestrzeni
+/// roboczej (kolejki i bufora odleglosci) dla wszystkich swoich zrodel. Graf jest tylko odczytywany.
+/// @tparam W typ wag krawedzi obslugiwany przez WeightTraits; odleglosci maja ten sam typ
+template <typename W>
+class BasicMultiSourceShortestPaths
+{
+    public:
+        /// @brief Konstruktor tworzacy wlasna pule watkow.
+        /// @param threads liczba watkow (0 - liczba rdzeni)
+        /// @param pin przypiecie watkow do kolejnych rdzeni (tylko Linux)
+        BasicMultiSourceShortestPaths(const sizeType& threads = 0, const bool& pin = false):
+            ownedPool{new ThreadPool(threads, pin)}, pool{ownedPool.get()} {}
+
+        /// @brief Konstruktor korzystajacy z istniejacej puli watkow.
+        /// @param pool pula watkow, ktora musi istniec dluzej niz ten obiekt
+        BasicMultiSourceShortestPaths(ThreadPool& pool): pool{&pool} {}
+
+        /// @brief Funkcja otrzymujaca wynik dla jednego zrodla: (numer zrodla na liscie, indeks wierzcholka, odleglosci).
+        /// Wywolywana jest rownolegle z roznych watkow, a tablica odleglosci jest wazna tylko w trakcie wywolania.
+        typedef std::function<void(sizeType, sizeType, const std::vector<W>&)> Callback;
+
+        /// @return Zwraca liczbe watkow.
+        sizeType threads() const
+            { return pool->size(); }
+
+        /// @brief Wyznacza odleglosci z kazdego zrodla i zapisuje je do macierzy wywolujacego.
+        /// @tparam Q kolejka priorytetowa adresowana indeksem wierzcholka (BinaryHeap, QuaternaryHeap, PairingHeap)
+        /// @tparam T typ elementow na wierzcholkach
+        /// @param graph referencja do nieskierowanego grafu prostego z nieujemnymi wagami krawedzi
+        /// @param sources indeksy wierzcholkow zrodlowych
+        /// @param matrix macierz sources.size() x sizeV() w porzadku wierszowym; wiersz r otrzymuje odleglosci od sources[r]
+        template <template <typename> class Q = BinaryHeap, typename T>
+        void run(const GraphADT<T,W>* graph, const std::vector<sizeType>& sources, W* matrix)
+        {
+            const sizeType n = graph->sizeV();
+            forEachSource<Q>(n, sources, [&](sizeType r, Workspace<Q>& w)
+            {
+                NoStats stats;
+                DijkstraAlgorithm::shortestPath(graph, graph->vertex(sources[r]), matrix + r * n, w.queue, stats);
+            });
+        }
+
+        /// @brief Wyznacza odleglosci z kazdego zrodla i przekazuje je do funkcji wywolujacego.
+        /// @tparam Q kolejka priorytetowa adresowana indeksem wierzcholka (BinaryHeap, QuaternaryHeap, PairingHeap)
+        /// @tparam T typ elementow na wierzcholkach
+        /// @param graph referencja do nieskierowanego grafu prostego z nieujemnymi wagami krawedzi
+        /// @param sources indeksy wierzcholkow zrodlowych
+        /// @param callback funkcja otrzymujaca wynik dla kazdego zrodla
+        template <template <typename> class Q = BinaryHeap, typename T>
+        void run(const GraphADT<T,W>* graph, const std::vector<sizeType>& sources, const Callback& callback)
+        {
+            forEachSource<Q>(graph->sizeV(), sources, [&](sizeType r, Workspace<Q>& w)
+            {
+                NoStats stats;
+                DijkstraAlgorithm::shortestPath(graph, graph->vertex(sources[r]), w.D.data(), w.queue, stats);
+                callback(r, sources[r], w.D);
+            });
+        }
+
+        /// @brief Wyznacza odleglosci z kazdego zrodla migawki CSR i zapisuje je do macierzy wywolujacego.
+        /// @tparam Q kolejka priorytetowa adresowana indeksem wierzcholka (BinaryHeap, QuaternaryHeap, PairingHeap)
+        /// @param graph graf w formacie CSR (CSRGraph, MappedGraph albo widok CSRView) z nieujemnymi wagami krawedzi
+        /// @param sources indeksy wierzcholkow zrodlowych
+        /// @param matrix macierz sources.size() x sizeV() w porzadku wierszowym; wiersz r otrzymuje odleglosci od sources[r]
+        template <template <typename> class Q = BinaryHeap>
+        void run(const CSRView<W>& graph, const std::vector<sizeType>& sources, W* matrix)
+        {
+            const sizeType n = graph.sizeV();
+            forEachSource<Q>(n, sources, [&](sizeType r, Workspace<Q>& w)
+            {
+                NoStats stats;
+                DijkstraAlgorithm::shortestPath(graph, sources[r], matrix + r * n, w.queue, stats);
+            });
+        }
+
+        /// @brief Wyznacza odleglosci z kazdego zrodla migawki CSR i przekazuje je do funkcji wywolujacego.
+        /// @tparam Q kolejka priorytetowa adresowana indeksem wierzcholka (BinaryHeap, QuaternaryHeap, PairingHeap)
+        /// @param graph graf w formacie CSR (CSRGraph, MappedGraph albo widok CSRView) z nieujemnymi wagami krawedzi
+        /// @param sources indeksy wierzcholkow zrodlowych
+        /// @param callback funkcja otrzymujaca wynik dla kazdego zrodla
+        template <template <typename> class Q = BinaryHeap>
+        void run(const CSRView<W>& graph, const std::vector<sizeType>& sources, const Callback& callback)
+        {
+            forEachSource<Q>(graph.sizeV(), sources, [&](sizeType r, Workspace<Q>& w)
+            {
+                NoStats stats;
+                DijkstraAlgorithm::shortestPath(graph, sources[r], w.D.data(), w.queue, stats);
+                callback(r, sources[r], w.D);
+            });
+        }
+
+        /// @brief Wyznacza macierz odleglosci miedzy wszystkimi parami wierzcholkow.
+        /// @tparam Q kolejka priorytetowa adresowana indeksem wierzcholka (BinaryHeap, QuaternaryHeap, PairingHeap)
+        /// @tparam G typ grafu (wskaznik na GraphADT albo graf w formacie CSR)
+        /// @param graph graf
+        /// @return Zwraca macierz sizeV() x sizeV() w porzadku wierszowym.
+        template <template <typename> class Q = BinaryHeap, typename G>
+        std::vector<W> allPairs(const G& graph)
+        {
+            const sizeType n = size(graph);
+            std::vector<sizeType> sources(n);
+            for (sizeType i = 0; i < n; i++)
+                sources[i] = i;
+            std::vector<W> matrix(n * n);
+            run<Q>(graph, sources, matrix.data());
+            return matrix;
+        }
+
+    private:
+        /// @brief Przestrzen robocza jednego watku, uzywana dla wszystkich jego zrodel.
+        template <template <typename> class Q>
+        struct Workspace
+        {
+            std::vector<W> D;
+            Q<W> queue;
+        };
+
+        template <template <typename> class Q, typename F>
+        void forEachSource(const sizeType& n, const std::vector<sizeType>& sources, const F& solve)
+        {
+            TRACE_SPAN("MultiSourceShortestPaths::run");
+            std::vector<std::unique_ptr<Workspace<Q>>> workspaces(pool->size());
+            pool->parallelFor(sources.size(), [&](sizeType worker, sizeType r)
+            {
+                // Przestrzen robocza tworzona jest przez watek, ktory jej uzywa, wiec trafia do jego pamieci lokalnej
+                std::unique_ptr<Workspace<Q>>& w = workspaces[worker];
+                if (!w)
+                {
+                    w.reset(new Workspace<Q>());
+                    w->D.resize(n);
+                    w->queue.resize(n);
+                }
+                solve(r, *w);
+            });
+        }
+
+        template <typename T>
+        static sizeType size(const GraphADT<T,W>* graph)
+            { return graph->sizeV(); }
+
+        static sizeType size(const CSRView<W>& graph)
+            { return graph.sizeV(); }
+
+        std::unique_ptr<ThreadPool> ownedPool;
+        ThreadPool* pool;
+};
+
+/// @brief Wyznaczanie najkrotszych sciezek z wielu zrodel dla grafow o wagach int.
+typedef BasicMultiSourceShortestPaths<int> MultiSourceShortestPaths;
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef OBJECT_POOL_HPP
+#define OBJECT_POOL_HPP
+
+#include <vector>
+#include <memory>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+#include "types.hpp"
+
+/// @brief Alokator plytowy (slab) obiektow jednego typu. Pamiec przydzielana jest blokami, ktore nie sa
+/// przenoszone ani zwalniane przed zniszczeniem puli, wiec adresy zywych obiektow pozostaja stale.
+/// Zwolnione miejsca trafiaja na liste wolnych i sa uzywane ponownie.
+/// @tparam X typ przechowywanych obiektow
+template <typename X>
+class ObjectPool
+{
+    public:
+        /// @brief Podstawowy konstruktor puli.
+        /// @param chunkSize liczba obiektow w pierwszym bloku, kolejne bloki sa dwukrotnie wieksze
+        ObjectPool(const sizeType& chunkSize = 64): nextChunkSize{chunkSize ? chunkSize : 1} {}
+
+        ObjectPool(const ObjectPool<X>&) = delete;
+        ObjectPool<X>& operator=(const ObjectPool<X>&) = delete;
+
+        /// @brief Tworzy obiekt w puli.
+        /// @param args argumenty konstruktora obiektu
+        /// @return Zwraca wskaznik na nowy obiekt.
+        template <typename... Args>
+        X* create(Args&&... args)
+            { return new (allocate()->storage) X(std::forward<Args>(args)...); }
+
+        /// @brief Niszczy obiekt i zwraca jego miejsce do ponownego uzycia.
+        /// @param p wskaznik na obiekt utworzony w tej puli
+        void destroy(X* p)
+        {
+            p->~X();
+            Slot* slot = reinterpret_cast<Slot*>(p);
+            slot->next = freeList;
+            freeList = slot;
+        }
+
+        /// @brief Zbiorczo niszczy wszystkie zywe obiekty. Bloki pamieci pozostaja w puli do ponownego uzycia.
+        /// @param live struktura wskaznikow na wszystkie zywe obiekty puli (moga byc typu bazowego X)
+        template <typename C>
+        void release(const C& live)
+        {
+            if constexpr (!std::is_trivially_destructible<X>::value)
+                for (auto & i : live)
+                    static_cast<X*>(i)->~X();
+            freeList = nullptr;
+            chunk = 0;
+            used = 0;
+        }
+
+        /// @brief Zapewnia miejsce na co najmniej n kolejnych obiektow bez alokacji pamieci.
+        /// @param n liczba obiektow
+        void reserve(const sizeType& n)
+        {
+            sizeType available = 0;
+            for (sizeType i = chunk; i < chunks.size(); i++)
+                available += capacities[i] - (i == chunk ? used : 0);
+            if (available < n)
+                addChunk(n - available);
+        }
+
+    private:
+        union Slot
+        {
+            Slot* next;
+            alignas(X) unsigned char storage[sizeof(X)];
+        };
+
+        Slot* allocate()
+        {
+            if (freeList)
+            {
+                Slot* slot = freeList;
+                freeList = freeList->next;
+                return slot;
+            }
+
+            while (chunk < chunks.size() && used == capacities[chunk])
+            {
+                ++chunk;
+                used = 0;
+            }
+            if (chunk == chunks.size())
+                addChunk(nextChunkSize);
+            return &chunks[chunk][used++];
+        }
+
+        void addChunk(const sizeType& size)
+        {
+            const sizeType capacity = size > nextChunkSize ? size : nextChunkSize;
+            chunks.push_back(std::unique_ptr<Slot[]>(new Slot[capacity]));
+            capacities.push_back(capacity);
+            nextChunkSize = 2 * capacity;
+        }
+
+        std::vector<std::unique_ptr<Slot[]>> chunks;
+        std::vector<sizeType> capacities;
+        sizeType nextChunkSize;
+
+        // Aktualny blok i liczba zajetych w nim miejsc
+        sizeType chunk = 0;
+        sizeType used = 0;
+
+        Slot* freeList = nullptr;
+};
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#include <array>
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+#include "types.hpp"
+
+/// @brief Wartosci licznikow sprzetowych dla jednego mierzonego fragmentu.
+/// Licznik niedostepny na danej maszynie ma wartosc NaN.
+struct PerfSample
+{
+    static constexpr sizeType EVENTS = 5;
+
+    // Kolejnosc: cykle, instrukcje, chybienia L1D (odczyt), chybienia LLC, bledne predykcje skokow
+    std::array<double, EVENTS> values;
+
+    PerfSample()
+        { values.fill(std::numeric_limits<double>::quiet_NaN()); }
+
+    /// @param i numer licznika
+    /// @return Zwraca nazwe licznika uzywana w raportach.
+    static const char* name(const sizeType& i)
+    {
+        static const char* names[EVENTS] = { "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses" };
+        return names[i];
+    }
+
+    /// @brief Wylicza mediane kazdego licznika, pomijajac wartosci niedostepne.
+    /// @param samples probki licznikow
+    /// @return Zwraca probke zawierajaca mediany.
+    static PerfSample median(const std::vector<PerfSample>& samples)
+    {
+        PerfSample out;
+        std::vector<double> column;
+        for (sizeType e = 0; e < EVENTS; e++)
+        {
+            column.clear();
+            for (auto & s : samples)
+                if (s.values[e] == s.values[e])
+                    column.push_back(s.values[e]);
+            if (column.empty())
+                continue;
+            std::sort(column.begin(), column.end());
+            const sizeType middle = column.size() / 2;
+            out.values[e] = column.size() % 2 ? column[middle] : (column[middle - 1] + column[middle]) / 2;
+        }
+        return out;
+    }
+};
+
+/// @brief Grupa licznikow sprzetowych (perf_event_open) dla watku, ktory utworzyl obiekt.
+/// Liczniki, ktorych nie da sie otworzyc (brak uprawnien, maszyna wirtualna, inny system niz Linux),
+/// sa pomijane, a ich wartosci w probkach pozostaja NaN.
+class PerfCounters
+{
+    public:
+        PerfCounters()
+        {
+            fds.fill(-1);
+#if defined(__linux__)
+            const std::uint32_t types[PerfSample::EVENTS] = {
+                PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE };
+            const std::uint64_t configs[PerfSample::EVENTS] = {
+                PERF_COUNT_HW_CPU_CYCLES,
+                PERF_COUNT_HW_INSTRUCTIONS,
+                PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+                PERF_COUNT_HW_CACHE_MISSES,
+                PERF_COUNT_HW_BRANCH_MISSES };
+
+            for (sizeType e = 0; e < PerfSample::EVENTS; e++)
+            {
+                perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                attr.type = types[e];
+                attr.config = configs[e];
+                attr.disabled = leader < 0 ? 1 : 0;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_GROUP;
+
+                long fd = syscall(__NR_perf_event_open, &attr, 0, -1, leader, 0);
+                if (fd < 0)
+                    continue;
+                fds[e] = static_cast<int>(fd);
+                order[opened++] = e;
+                if (leader < 0)
+                    leader = static_cast<int>(fd);
+            }
+#endif
+        }
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        ~PerfCounters()
+        {
+#if defined(__linux__)
+            for (auto & fd : fds)
+                if (fd >= 0)
+                    close(fd);
+#endif
+        }
+
+        /// @return Zwraca prawde jezeli udalo sie otworzyc co najmniej jeden licznik.
+        bool available() const
+            { return leader >= 0; }
+
+        /// @brief Zeruje i uruchamia liczniki.
+        void start()
+        {
+#if defined(__linux__)
+            if (leader < 0)
+                return;
+            ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+        }
+
+        /// @brief Zatrzymuje liczniki.
+        /// @return Zwraca wartosci licznikow od ostatniego wywolania start().
+        PerfSample stop()
+        {
+            PerfSample sample;
+#if defined(__linux__)
+            if (leader < 0)
+                return sample;
+            ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+            // Format PERF_FORMAT_GROUP: liczba licznikow, a po niej ich wartosci w kolejnosci otwarcia
+            std::uint64_t buffer[1 + PerfSample::EVENTS] = {};
+            if (read(leader, buffer, sizeof(buffer)) <= 0)
+                return sample;
+            for (sizeType i = 0; i < buffer[0] && i < opened; i++)
+                sample.values[order[i]] = static_cast<double>(buffer[1 + i]);
+#endif
+            return sample;
+        }
+
+    private:
+        std::array<int, PerfSample::EVENTS> fds;
+        std::array<sizeType, PerfSample::EVENTS> order{};
+        sizeType opened = 0;
+        int leader = -1;
+};
+
+#endif
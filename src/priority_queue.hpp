@@ -0,0 +1,349 @@
+#ifndef PRIORITY_QUEUE_HPP
+#define PRIORITY_QUEUE_HPP
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+#include "types.hpp"
+
+/// @brief Kopiec d-arny adresowany indeksem elementu (np. Vertex::i). Udostepnia operacje decreaseKey.
+/// Indeksy i pozycje zapisywane sa jako 32-bitowe, wiec wezel z 4-bajtowym kluczem zajmuje 8 bajtow.
+/// @tparam K typ klucza (priorytetu)
+/// @tparam D arnosc kopca
+template <typename K, sizeType D>
+class DaryHeap
+{
+    static_assert(D >= 2, "Arnosc kopca musi wynosic co najmniej 2");
+
+    public:
+        /// @brief Podstawowy konstruktor kopca.
+        /// @param capacity liczba adresowalnych indeksow (zwykle liczba wierzcholkow grafu)
+        DaryHeap(const sizeType& capacity = 0): position(capacity, NONE) {}
+
+        /// @brief Oproznia kopiec i ustawia nowa liczbe adresowalnych indeksow.
+        /// @param capacity liczba adresowalnych indeksow
+        void resize(const sizeType& capacity)
+        {
+            clear();
+            position.assign(capacity, NONE);
+        }
+
+        /// @brief Oproznia kopiec. Koszt proporcjonalny do liczby elementow w kopcu.
+        void clear()
+        {
+            for (auto & i : heap)
+                position[i.index] = NONE;
+            heap.clear();
+        }
+
+        /// @return Zwraca prawde jezeli kopiec jest pusty.
+        bool empty() const
+            { return heap.empty(); }
+
+        /// @return Zwraca liczbe elementow w kopcu.
+        sizeType size() const
+            { return heap.size(); }
+
+        /// @param index indeks elementu
+        /// @return Zwraca prawde jezeli element znajduje sie w kopcu.
+        bool contains(const sizeType& index) const
+            { return position[index] != NONE; }
+
+        /// @return Zwraca indeks elementu o najmniejszym kluczu.
+        sizeType top() const
+            { return heap.front().index; }
+
+        /// @return Zwraca najmniejszy klucz w kopcu.
+        const K& topKey() const
+            { return heap.front().key; }
+
+        /// @brief Usuwa element o najmniejszym kluczu.
+        void pop()
+        {
+            position[heap.front().index] = NONE;
+            if (heap.size() > 1)
+            {
+                heap.front() = heap.back();
+                heap.pop_back();
+                position[heap.front().index] = 0;
+                siftDown(0);
+            }
+            else
+                heap.pop_back();
+        }
+
+        /// @brief Dodaje element do kopca.
+        /// @param index indeks elementu, ktorego nie ma w kopcu
+        /// @param key klucz elementu
+        void push(const sizeType& index, const K& key)
+        {
+            position[index] = static_cast<std::uint32_t>(heap.size());
+            heap.push_back(Node{ key, static_cast<std::uint32_t>(index) });
+            siftUp(heap.size() - 1);
+        }
+
+        /// @brief Zmniejsza klucz elementu znajdujacego sie w kopcu.
+        /// @param index indeks elementu
+        /// @param key nowy klucz, nie wiekszy od aktualnego
+        void decreaseKey(const sizeType& index, const K& key)
+        {
+            heap[position[index]].key = key;
+            siftUp(position[index]);
+        }
+
+        /// @brief Dodaje element do kopca albo zmniejsza jego klucz, jezeli juz sie w nim znajduje.
+        /// @param index indeks elementu
+        /// @param key klucz elementu
+        void pushOrDecrease(const sizeType& index, const K& key)
+        {
+            if (contains(index))
+                decreaseKey(index, key);
+            else
+                push(index, key);
+        }
+
+    private:
+        struct Node
+        {
+            K key;
+            std::uint32_t index;
+        };
+
+        static constexpr std::uint32_t NONE = UINT32_MAX;
+
+        void siftUp(sizeType pos)
+        {
+            Node node = heap[pos];
+            while (pos > 0)
+            {
+                sizeType parent = (pos - 1) / D;
+                if (!(node.key < heap[parent].key))
+                    break;
+                heap[pos] = heap[parent];
+                position[heap[pos].index] = pos;
+                pos = parent;
+            }
+            heap[pos] = node;
+            position[node.index] = pos;
+        }
+
+        void siftDown(sizeType pos)
+        {
+            Node node = heap[pos];
+            const sizeType n = heap.size();
+            while (true)
+            {
+                sizeType first = pos * D + 1;
+                if (first >= n)
+                    break;
+                sizeType last = first + D < n ? first + D : n;
+                sizeType best = first;
+                for (sizeType i = first + 1; i < last; i++)
+                    if (heap[i].key < heap[best].key)
+                        best = i;
+                if (!(heap[best].key < node.key))
+                    break;
+                heap[pos] = heap[best];
+                position[heap[pos].index] = pos;
+                pos = best;
+            }
+            heap[pos] = node;
+            position[node.index] = pos;
+        }
+
+        std::vector<Node> heap;
+        std::vector<std::uint32_t> position;
+};
+
+/// @brief Kopiec binarny adresowany indeksem elementu.
+template <typename K>
+using BinaryHeap = DaryHeap<K,2>;
+
+/// @brief Kopiec 4-arny adresowany indeksem elementu.
+template <typename K>
+using QuaternaryHeap = DaryHeap<K,4>;
+
+/// @brief Kopiec parujacy adresowany indeksem elementu. Wezly przechowywane sa w tablicy, bez alokacji na element.
+/// Dowiazania wezlow sa 32-bitowymi indeksami, jak w DaryHeap, wiec wezel z 4-bajtowym kluczem zajmuje 20 bajtow.
+/// @tparam K typ klucza (priorytetu)
+template <typename K>
+class PairingHeap
+{
+    public:
+        /// @brief Podstawowy konstruktor kopca.
+        /// @param capacity liczba adresowalnych indeksow (zwykle liczba wierzcholkow grafu)
+        PairingHeap(const sizeType& capacity = 0): nodes(capacity) {}
+
+        /// @brief Oproznia kopiec i ustawia nowa liczbe adresowalnych indeksow.
+        /// @param capacity liczba adresowalnych indeksow
+        void resize(const sizeType& capacity)
+        {
+            nodes.assign(capacity, Node());
+            root = NONE;
+            count = 0;
+        }
+
+        /// @brief Oproznia kopiec. Koszt proporcjonalny do liczby elementow w kopcu.
+        void clear()
+        {
+            if (root != NONE)
+            {
+                scratch.clear();
+                scratch.push_back(root);
+                while (!scratch.empty())
+                {
+                    std::uint32_t x = scratch.back();
+                    scratch.pop_back();
+                    for (std::uint32_t c = nodes[x].child; c != NONE; c = nodes[c].sibling)
+                        scratch.push_back(c);
+                    nodes[x] = Node();
+                }
+            }
+            root = NONE;
+            count = 0;
+        }
+
+        /// @return Zwraca prawde jezeli kopiec jest pusty.
+        bool empty() const
+            { return root == NONE; }
+
+        /// @return Zwraca liczbe elementow w kopcu.
+        sizeType size() const
+            { return count; }
+
+        /// @param index indeks elementu
+        /// @return Zwraca prawde jezeli element znajduje sie w kopcu.
+        bool contains(const sizeType& index) const
+            { return nodes[index].inHeap; }
+
+        /// @return Zwraca indeks elementu o najmniejszym kluczu.
+        sizeType top() const
+            { return root; }
+
+        /// @return Zwraca najmniejszy klucz w kopcu.
+        const K& topKey() const
+            { return nodes[root].key; }
+
+        /// @brief Usuwa element o najmniejszym kluczu.
+        void pop()
+        {
+            std::uint32_t old = root;
+            root = mergePairs(nodes[old].child);
+            if (root != NONE)
+                nodes[root].prev = NONE;
+            nodes[old] = Node();
+            --count;
+        }
+
+        /// @brief Dodaje element do kopca.
+        /// @param index indeks elementu, ktorego nie ma w kopcu
+        /// @param key klucz elementu
+        void push(const sizeType& index, const K& key)
+        {
+            Node& node = nodes[index];
+            node.key = key;
+            node.child = node.sibling = node.prev = NONE;
+            node.inHeap = true;
+            root = root == NONE ? static_cast<std::uint32_t>(index) : meld(root, static_cast<std::uint32_t>(index));
+            ++count;
+        }
+
+        /// @brief Zmniejsza klucz elementu znajdujacego sie w kopcu.
+        /// @param index indeks elementu
+        /// @param key nowy klucz, nie wiekszy od aktualnego
+        void decreaseKey(const sizeType& index, const K& key)
+        {
+            nodes[index].key = key;
+            if (index == root)
+                return;
+
+            // Odciecie poddrzewa od rodzica lub lewego brata
+            Node& node = nodes[index];
+            if (nodes[node.prev].child == index)
+                nodes[node.prev].child = node.sibling;
+            else
+                nodes[node.prev].sibling = node.sibling;
+            if (node.sibling != NONE)
+                nodes[node.sibling].prev = node.prev;
+            node.sibling = node.prev = NONE;
+
+            root = meld(root, static_cast<std::uint32_t>(index));
+        }
+
+        /// @brief Dodaje element do kopca albo zmniejsza jego klucz, jezeli juz sie w nim znajduje.
+        /// @param index indeks elementu
+        /// @param key klucz elementu
+        void pushOrDecrease(const sizeType& index, const K& key)
+        {
+            if (contains(index))
+                decreaseKey(index, key);
+            else
+                push(index, key);
+        }
+
+    private:
+        static constexpr std::uint32_t NONE = UINT32_MAX;
+
+        struct Node
+        {
+            K key{};
+            std::uint32_t child = NONE;
+            std::uint32_t sibling = NONE;
+            // Rodzic dla pierwszego dziecka, w przeciwnym wypadku lewy brat
+            std::uint32_t prev = NONE;
+            bool inHeap = false;
+        };
+
+        /// @brief Laczy dwa drzewa, ktorych korzenie nie maja rodzenstwa.
+        /// @return Zwraca korzen polaczonego drzewa.
+        std::uint32_t meld(std::uint32_t a, std::uint32_t b)
+        {
+            if (nodes[b].key < nodes[a].key)
+                std::swap(a, b);
+            Node& parent = nodes[a];
+            Node& child = nodes[b];
+            child.sibling = parent.child;
+            if (parent.child != NONE)
+                nodes[parent.child].prev = b;
+            child.prev = a;
+            parent.child = b;
+            return a;
+        }
+
+        /// @brief Dwuprzebiegowe laczenie listy rodzenstwa.
+        /// @param first pierwszy element listy
+        /// @return Zwraca korzen wynikowego drzewa.
+        std::uint32_t mergePairs(std::uint32_t first)
+        {
+            if (first == NONE)
+                return NONE;
+
+            scratch.clear();
+            while (first != NONE)
+            {
+                std::uint32_t a = first;
+                std::uint32_t b = nodes[a].sibling;
+                first = b == NONE ? NONE : nodes[b].sibling;
+                nodes[a].sibling = nodes[a].prev = NONE;
+                if (b != NONE)
+                {
+                    nodes[b].sibling = nodes[b].prev = NONE;
+                    a = meld(a, b);
+                }
+                scratch.push_back(a);
+            }
+
+            std::uint32_t result = scratch.back();
+            for (sizeType i = scratch.size() - 1; i-- > 0;)
+                result = meld(scratch[i], result);
+            return result;
+        }
+
+        std::vector<Node> nodes;
+        std::vector<std::uint32_t> scratch;
+        std::uint32_t root = NONE;
+        sizeType count = 0;
+};
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef SHORTEST_PATH_TREE_HPP
+#define SHORTEST_PATH_TREE_HPP
+
+#include <vector>
+#include <climits>
+#include <cstdint>
+#include <algorithm>
+
+#include "csr_graph.hpp"
+#include "weight_traits.hpp"
+
+/// @brief Drzewo najkrotszych sciezek z jednego zrodla: odleglosci i poprzedniki wszystkich wierzcholkow.
+/// Poprzedniki zapisane sa jako 32-bitowe indeksy wierzcholkow, a sciezka do wybranego celu odtwarzana
+/// jest dopiero na zadanie, wiec jedno wykonanie algorytmu obsluguje dowolnie wiele celow.
+/// @tparam W typ odleglosci (typ wag krawedzi)
+template <typename W>
+class BasicShortestPathTree
+{
+    public:
+        /// @brief Poprzednik zrodla i wierzcholkow nieosiagalnych.
+        static constexpr std::uint32_t NONE = UINT32_MAX;
+
+        BasicShortestPathTree() = default;
+
+        /// @brief Konstruktor przejmujacy wynik algorytmu.
+        /// @param source indeks wierzcholka zrodlowego
+        /// @param distances dlugosci sciezek (WeightTraits<W>::infinity() dla wierzcholkow nieosiagalnych)
+        /// @param predecessors poprzedniki wierzcholkow na najkrotszych sciezkach
+        BasicShortestPathTree(const sizeType& source, std::vector<W> distances, std::vector<std::uint32_t> predecessors):
+            root{source}, D{std::move(distances)}, P{std::move(predecessors)} {}
+
+        /// @return Zwraca liczbe wierzcholkow.
+        sizeType sizeV() const
+            { return D.size(); }
+
+        /// @return Zwraca indeks wierzcholka zrodlowego.
+        sizeType source() const
+            { return root; }
+
+        /// @param target indeks wierzcholka
+        /// @return Zwraca dlugosc najkrotszej sciezki albo WeightTraits<W>::infinity(), jezeli wierzcholek jest nieosiagalny.
+        const W& distance(const sizeType& target) const
+            { return D[target]; }
+
+        /// @param target indeks wierzcholka
+        /// @return Zwraca prawde, jezeli wierzcholek jest osiagalny ze zrodla.
+        bool reachable(const sizeType& target) const
+            { return D[target] != WeightTraits<W>::infinity(); }
+
+        /// @param target indeks wierzcholka
+        /// @return Zwraca poprzednik wierzcholka na najkrotszej sciezce albo NONE.
+        std::uint32_t predecessor(const sizeType& target) const
+            { return P[target]; }
+
+        /// @return Zwraca dlugosci sciezek do kazdego wierzcholka.
+        const std::vector<W>& distances() const
+            { return D; }
+
+        /// @return Zwraca poprzedniki wszystkich wierzcholkow.
+        const std::vector<std::uint32_t>& predecessors() const
+            { return P; }
+
+        /// @brief Odtwarza najkrotsza sciezke, przechodzac po poprzednikach od celu do zrodla.
+        /// @param target indeks wierzcholka docelowego
+        /// @return Zwraca indeksy kolejnych wierzcholkow od zrodla do celu (puste, jezeli cel jest nieosiagalny).
+        std::vector<sizeType> path(const sizeType& target) const
+        {
+            std::vector<sizeType> result;
+            if (!reachable(target))
+                return result;
+            for (sizeType x = target; x != NONE; x = P[x])
+                result.push_back(x);
+            std::reverse(result.begin(), result.end());
+            return result;
+        }
+
+    private:
+        sizeType root = 0;
+        std::vector<W> D;
+        std::vector<std::uint32_t> P;
+};
+
+/// @brief Drzewo najkrotszych sciezek grafu o wagach int.
+typedef BasicShortestPathTree<int> ShortestPathTree;
+
+#endif
@@ -0,0 +1,201 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <string>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "types.hpp"
+#include "trace.hpp"
+
+/// @brief Pula watkow wykonujaca petle rownolegle z podkradaniem pracy (work stealing). Watek wywolujacy
+/// pracuje jako watek numer 0, a pozostale watki czekaja na kolejne zadania miedzy wywolaniami.
+class ThreadPool
+{
+    public:
+        /// @brief Podstawowy konstruktor puli.
+        /// @param threads liczba watkow lacznie z watkiem wywolujacym (0 - liczba rdzeni)
+        /// @param pin przypiecie watku i do rdzenia i (tylko Linux)
+        ThreadPool(sizeType threads = 0, const bool& pin = false)
+        {
+            if (threads == 0)
+                threads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+            ranges = std::vector<Range>(threads);
+            if (pin)
+                pinToCore(0);
+            for (sizeType i = 1; i < threads; i++)
+                workers.emplace_back([this, i, pin]
+                {
+                    if (pin)
+                        pinToCore(i);
+                    Tracer::nameThread("worker " + std::to_string(i));
+                    loop(i);
+                });
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stop = true;
+            }
+            wake.notify_all();
+            for (auto & i : workers)
+                i.join();
+        }
+
+        /// @return Zwraca liczbe watkow lacznie z watkiem wywolujacym.
+        sizeType size() const
+            { return workers.size() + 1; }
+
+        /// @brief Wykonuje fn(watek, indeks) dla kazdego indeksu z przedzialu [0, count). Kazdy watek otrzymuje
+        /// ciagly przedzial indeksow i pobiera je od poczatku, a po jego wyczerpaniu podkrada druga polowe
+        /// pozostalej pracy innego watku. Funkcja wraca po przetworzeniu wszystkich indeksow.
+        /// @param count liczba indeksow
+        /// @param fn funkcja wywolywana dla kazdego indeksu
+        void parallelFor(const sizeType& count, const std::function<void(sizeType, sizeType)>& fn)
+        {
+            if (workers.empty())
+            {
+                for (sizeType i = 0; i < count; i++)
+                    fn(0, i);
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                job = &fn;
+                for (sizeType w = 0; w < ranges.size(); w++)
+                {
+                    std::lock_guard<std::mutex> rangeLock(ranges[w].mutex);
+                    ranges[w].begin = count * w / ranges.size();
+                    ranges[w].end = count * (w + 1) / ranges.size();
+                }
+                pending = workers.size();
+                ++generation;
+            }
+            wake.notify_all();
+
+            work(0);
+
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [this] { return pending == 0; });
+            job = nullptr;
+        }
+
+    private:
+        void loop(const sizeType& worker)
+        {
+            sizeType seen = 0;
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    wake.wait(lock, [this, seen] { return stop || generation != seen; });
+                    if (stop)
+                        return;
+                    seen = generation;
+                }
+
+                work(worker);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if (--pending == 0)
+                    done.notify_one();
+            }
+        }
+
+        /// @brief Przedzial indeksow nalezacy do watku. Wyrownanie zapobiega falszywemu wspoldzieleniu linii pamieci.
+        struct alignas(64) Range
+        {
+            std::mutex mutex;
+            sizeType begin = 0;
+            sizeType end = 0;
+        };
+
+        void work(const sizeType& worker)
+        {
+            sizeType i;
+            while (true)
+            {
+                while (take(worker, i))
+                    (*job)(worker, i);
+                if (!steal(worker))
+                    return;
+            }
+        }
+
+        /// @brief Pobiera pierwszy indeks z wlasnego przedzialu.
+        bool take(const sizeType& worker, sizeType& i)
+        {
+            Range& own = ranges[worker];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (own.begin == own.end)
+                return false;
+            i = own.begin++;
+            return true;
+        }
+
+        /// @brief Przenosi do wlasnego przedzialu druga polowe pracy pierwszego niepustego watku.
+        /// Praca nie przybywa w trakcie petli, wiec brak pracy u wszystkich oznacza koniec.
+        /// @return Zwraca falsz, jezeli zadny watek nie ma juz pracy.
+        bool steal(const sizeType& worker)
+        {
+            for (sizeType k = 1; k < ranges.size(); k++)
+            {
+                Range& victim = ranges[(worker + k) % ranges.size()];
+                sizeType begin, end;
+                {
+                    std::lock_guard<std::mutex> lock(victim.mutex);
+                    if (victim.begin == victim.end)
+                        continue;
+                    begin = victim.begin + (victim.end - victim.begin) / 2;
+                    end = victim.end;
+                    victim.end = begin;
+                }
+                Range& own = ranges[worker];
+                std::lock_guard<std::mutex> lock(own.mutex);
+                own.begin = begin;
+                own.end = end;
+                return true;
+            }
+            return false;
+        }
+
+        static void pinToCore(const sizeType& core)
+        {
+#if defined(__linux__)
+            const unsigned cores = std::thread::hardware_concurrency();
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cores ? core % cores : 0, &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+        }
+
+        std::vector<std::thread> workers;
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+
+        std::vector<Range> ranges;
+
+        const std::function<void(sizeType, sizeType)>* job = nullptr;
+        sizeType pending = 0;
+        sizeType generation = 0;
+        bool stop = false;
+};
+
+#endif
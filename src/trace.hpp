@@ -0,0 +1,220 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+
+#include "types.hpp"
+
+/// @brief Zapis przedzialow czasu (spanow) do buforow lokalnych dla watkow i eksport w formacie
+/// Chrome trace-event JSON (chrome://tracing, ui.perfetto.dev). Sledzenie jest domyslnie wylaczone;
+/// wylaczony span kosztuje jedno odczytanie flagi atomowej.
+class Tracer
+{
+    public:
+        /// @brief Maksymalna liczba zdarzen w buforze jednego watku. Nadmiarowe zdarzenia sa pomijane i zliczane.
+        static constexpr sizeType bufferCapacity = 1 << 20;
+
+        /// @brief Wlacza sledzenie i nadaje watkowi wywolujacemu nazwe "main". Przy zakonczeniu programu
+        /// zdarzenia zostana zapisane do pliku.
+        /// @param filePath sciezka do pliku .json (pusta - bez zapisu przy zakonczeniu)
+        static void start(const std::string& filePath)
+        {
+            Tracer& tracer = instance();
+            nameThread("main");
+            {
+                std::lock_guard<std::mutex> lock(tracer.mutex);
+                tracer.outputPath = filePath;
+            }
+            tracer.active.store(true, std::memory_order_relaxed);
+        }
+
+        /// @brief Wylacza sledzenie. Zebrane zdarzenia pozostaja w buforach.
+        static void stop()
+            { instance().active.store(false, std::memory_order_relaxed); }
+
+        /// @return Zwraca prawde jezeli sledzenie jest wlaczone.
+        static bool enabled()
+            { return instance().active.load(std::memory_order_relaxed); }
+
+        /// @return Zwraca liczbe nanosekund od utworzenia obiektu sledzacego.
+        static std::uint64_t now()
+        {
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - instance().epoch).count());
+        }
+
+        /// @brief Dopisuje zakonczony span do bufora biezacego watku. Nie wymaga blokady.
+        /// @param name nazwa spanu, napis o statycznym czasie zycia
+        /// @param start poczatek w nanosekundach (Tracer::now())
+        /// @param end koniec w nanosekundach (Tracer::now())
+        static void record(const char* name, const std::uint64_t& start, const std::uint64_t& end)
+        {
+            Buffer& buffer = localBuffer();
+            if (buffer.events.size() == bufferCapacity)
+            {
+                ++buffer.dropped;
+                return;
+            }
+            buffer.events.push_back(Event{ name, start, end - start });
+        }
+
+        /// @brief Nadaje biezacemu watkowi nazwe widoczna na osi czasu.
+        /// @param name nazwa watku
+        static void nameThread(const std::string& name)
+            { localBuffer().name = name; }
+
+        /// @brief Zapisuje zdarzenia wszystkich watkow do pliku. Watki nie powinny w tym czasie zapisywac spanow.
+        /// @param filePath sciezka do pliku .json
+        static void dump(const std::string& filePath)
+            { instance().write(filePath); }
+
+        /// @brief Usuwa zdarzenia ze wszystkich buforow. Watki nie powinny w tym czasie zapisywac spanow.
+        static void reset()
+        {
+            Tracer& tracer = instance();
+            std::lock_guard<std::mutex> lock(tracer.mutex);
+            for (auto & buffer : tracer.buffers)
+            {
+                buffer->events.clear();
+                buffer->dropped = 0;
+            }
+        }
+
+        ~Tracer()
+        {
+            if (!outputPath.empty())
+                write(outputPath);
+        }
+
+    private:
+        struct Event
+        {
+            const char* name;
+            std::uint64_t start;
+            std::uint64_t duration;
+        };
+
+        struct Buffer
+        {
+            std::vector<Event> events;
+            sizeType dropped = 0;
+            sizeType tid = 0;
+            std::string name;
+        };
+
+        Tracer(): epoch{std::chrono::steady_clock::now()} {}
+
+        static Tracer& instance()
+        {
+            static Tracer tracer;
+            return tracer;
+        }
+
+        void write(const std::string& filePath)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::ofstream output(filePath);
+            output << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+
+            bool first = true;
+            for (auto & buffer : buffers)
+            {
+                output << (first ? "\n" : ",\n")
+                       << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << buffer->tid
+                       << ", \"args\": {\"name\": " << quote(buffer->name.empty() ? "thread " + std::to_string(buffer->tid) : buffer->name) << "}}";
+                first = false;
+
+                // Znaczniki czasu w formacie trace-event podawane sa w mikrosekundach
+                for (auto & e : buffer->events)
+                    output << ",\n{\"name\": " << quote(e.name) << ", \"ph\": \"X\", \"pid\": 1, \"tid\": " << buffer->tid
+                           << ", \"ts\": " << e.start / 1000 << '.' << digits(e.start % 1000)
+                           << ", \"dur\": " << e.duration / 1000 << '.' << digits(e.duration % 1000) << "}";
+                if (buffer->dropped)
+                    output << ",\n{\"name\": \"dropped " << buffer->dropped << " events\", \"ph\": \"i\", \"s\": \"t\", \"pid\": 1, \"tid\": "
+                           << buffer->tid << ", \"ts\": 0}";
+            }
+            output << "\n]}\n" << std::flush;
+        }
+
+        /// @return Zwraca bufor biezacego watku, rejestrujac go przy pierwszym uzyciu. Bufory naleza do
+        /// obiektu sledzacego, wiec zdarzenia zakonczonych watkow trafiaja do pliku.
+        static Buffer& localBuffer()
+        {
+            static thread_local Buffer* local = nullptr;
+            if (!local)
+            {
+                Tracer& tracer = instance();
+                std::lock_guard<std::mutex> lock(tracer.mutex);
+                tracer.buffers.emplace_back(new Buffer());
+                local = tracer.buffers.back().get();
+                local->tid = tracer.buffers.size();
+            }
+            return *local;
+        }
+
+        /// @return Zwraca tekst w cudzyslowie jako napis JSON (znaki sterujace sa pomijane).
+        static std::string quote(const std::string& text)
+        {
+            std::string out = "\"";
+            for (auto & c : text)
+            {
+                if (c == '"' || c == '\\')
+                    out += '\\';
+                if (static_cast<unsigned char>(c) >= 0x20)
+                    out += c;
+            }
+            return out + "\"";
+        }
+
+        static std::string digits(const std::uint64_t& fraction)
+        {
+            std::string text = std::to_string(fraction);
+            return std::string(3 - text.size(), '0') + text;
+        }
+
+        std::chrono::steady_clock::time_point epoch;
+        std::atomic<bool> active{false};
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Buffer>> buffers;
+        std::string outputPath;
+};
+
+/// @brief Span RAII: mierzy czas od utworzenia do zniszczenia obiektu i zapisuje go, jezeli sledzenie jest wlaczone.
+class TraceSpan
+{
+    public:
+        /// @param name nazwa spanu, napis o statycznym czasie zycia
+        TraceSpan(const char* name): name{Tracer::enabled() ? name : nullptr}, start{this->name ? Tracer::now() : 0} {}
+
+        TraceSpan(const TraceSpan&) = delete;
+        TraceSpan& operator=(const TraceSpan&) = delete;
+
+        ~TraceSpan()
+        {
+            if (name)
+                Tracer::record(name, start, Tracer::now());
+        }
+
+    private:
+        const char* name;
+        std::uint64_t start;
+};
+
+#define _trace_concat_inner(a, b) a##b
+#define _trace_concat(a, b) _trace_concat_inner(a, b)
+
+// Kompilacja z -DNO_TRACE usuwa spany calkowicie
+#ifdef NO_TRACE
+#define TRACE_SPAN(name)
+#else
+#define TRACE_SPAN(name) TraceSpan _trace_concat(_trace_span_, __LINE__)(name)
+#endif
+
+#endif
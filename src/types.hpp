@@ -0,0 +1,9 @@
+#ifndef TYPES_HPP
+#define TYPES_HPP
+
+#include <cstddef>
+
+/// @brief Typ rozmiarow i indeksow wspolny dla wszystkich naglowkow projektu.
+typedef std::size_t sizeType;
+
+#endif
@@ -0,0 +1,142 @@
+#ifndef WEIGHT_TRAITS_HPP
+#define WEIGHT_TRAITS_HPP
+
+#include <cmath>
+#include <limits>
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+
+/// @brief Liczba stalopozycyjna o F bitach czesci ulamkowej, przechowywana jako liczba calkowita R.
+/// Dodawanie i porownania sa operacjami calkowitymi, wiec wyniki nie zaleza od kolejnosci sumowania
+/// jak przy liczbach zmiennopozycyjnych.
+/// @tparam F liczba bitow czesci ulamkowej
+/// @tparam R typ calkowity przechowujacy wartosc
+template <unsigned F, typename R = std::int32_t>
+class FixedPoint
+{
+    static_assert(std::is_integral<R>::value && F < 8 * sizeof(R) - std::is_signed<R>::value, "Czesc ulamkowa musi miescic sie w typie R");
+
+    public:
+        /// @brief Wartosc surowa odpowiadajaca jedynce.
+        static constexpr R ONE = R(1) << F;
+
+        constexpr FixedPoint() = default;
+
+        /// @brief Konstruktor zaokraglajacy liczbe zmiennopozycyjna do najblizszej wartosci stalopozycyjnej.
+        /// @param value wartosc
+        explicit FixedPoint(const double& value): raw{static_cast<R>(std::llround(value * ONE))} {}
+
+        /// @param value wartosc surowa
+        /// @return Zwraca liczbe o podanej wartosci surowej.
+        static constexpr FixedPoint fromRaw(const R& value)
+        {
+            FixedPoint x;
+            x.raw = value;
+            return x;
+        }
+
+        /// @return Zwraca najwieksza reprezentowalna wartosc.
+        static constexpr FixedPoint max()
+            { return fromRaw(std::numeric_limits<R>::max()); }
+
+        /// @return Zwraca wartosc surowa.
+        constexpr R rawValue() const
+            { return raw; }
+
+        /// @return Zwraca wartosc jako liczbe zmiennopozycyjna.
+        double toDouble() const
+            { return static_cast<double>(raw) / ONE; }
+
+        constexpr FixedPoint operator+(const FixedPoint& other) const
+            { return fromRaw(raw + other.raw); }
+
+        constexpr FixedPoint operator-(const FixedPoint& other) const
+            { return fromRaw(raw - other.raw); }
+
+        constexpr bool operator==(const FixedPoint& other) const
+            { return raw == other.raw; }
+
+        constexpr bool operator!=(const FixedPoint& other) const
+            { return raw != other.raw; }
+
+        constexpr bool operator<(const FixedPoint& other) const
+            { return raw < other.raw; }
+
+        constexpr bool operator<=(const FixedPoint& other) const
+            { return raw <= other.raw; }
+
+        constexpr bool operator>(const FixedPoint& other) const
+            { return raw > other.raw; }
+
+        constexpr bool operator>=(const FixedPoint& other) const
+            { return raw >= other.raw; }
+
+        friend std::ostream& operator<<(std::ostream& out, const FixedPoint& x)
+            { return out << x.toDouble(); }
+
+    private:
+        R raw = 0;
+};
+
+template <typename W>
+struct IsFixedPoint : std::false_type {};
+
+template <unsigned F, typename R>
+struct IsFixedPoint<FixedPoint<F,R>> : std::true_type {};
+
+/// @brief Wlasnosci typu wag krawedzi potrzebne algorytmom najkrotszych sciezek: nieskonczonosc, dodawanie bez
+/// przepelnienia i warunek relaksacji. Odleglosci maja ten sam typ co wagi, wiec 32-bitowe wagi daja 32-bitowe
+/// tablice odleglosci i klucze kolejki. Wariant wybierany jest w czasie kompilacji:
+/// - int: nieskonczonosc INT_MAX, warunek zapisany jako roznica (jak dotychczas),
+/// - pozostale typy calkowite i FixedPoint: nieskonczonosc rowna najwiekszej wartosci, dodawanie z nasyceniem,
+/// - float i double: nieskonczonosc IEEE, ktora dodawanie zachowuje bez dodatkowych sprawdzen.
+/// @tparam W typ wag krawedzi
+template <typename W>
+struct WeightTraits
+{
+    static_assert(std::is_arithmetic<W>::value || IsFixedPoint<W>::value, "Nieobslugiwany typ wag krawedzi");
+
+    /// @return Zwraca odleglosc wierzcholkow nieosiagalnych.
+    static constexpr W infinity()
+    {
+        if constexpr (std::is_floating_point<W>::value)
+            return std::numeric_limits<W>::infinity();
+        else if constexpr (IsFixedPoint<W>::value)
+            return W::max();
+        else
+            return std::numeric_limits<W>::max();
+    }
+
+    /// @return Zwraca odleglosc zrodla.
+    static constexpr W zero()
+        { return W(); }
+
+    /// @param a nieujemna odleglosc
+    /// @param b nieujemna waga
+    /// @return Zwraca sume a + b, nie wieksza niz infinity().
+    static W add(const W& a, const W& b)
+    {
+        if constexpr (std::is_floating_point<W>::value)
+            return a + b;
+        else if constexpr (IsFixedPoint<W>::value)
+            return b.rawValue() > infinity().rawValue() - a.rawValue() ? infinity() : a + b;
+        else
+            return b > infinity() - a ? infinity() : static_cast<W>(a + b);
+    }
+
+    /// @param du odleglosc wierzcholka u
+    /// @param w waga krawedzi u-z
+    /// @param dz odleglosc wierzcholka z
+    /// @return Zwraca prawde, jezeli sciezka przez u jest krotsza niz dz.
+    static bool improves(const W& du, const W& w, const W& dz)
+    {
+        // Dla typow ze znakiem roznica nieujemnych odleglosci nie przepelnia sie, wiec wystarcza jedno porownanie
+        if constexpr (std::is_integral<W>::value && std::is_signed<W>::value)
+            return w < dz - du;
+        else
+            return add(du, w) < dz;
+    }
+};
+
+#endif
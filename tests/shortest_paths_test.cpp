@@ -0,0 +1,1185 @@
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <memory>
+#include <climits>
+#include <cstdint>
+#include <algorithm>
+#include <random>
+#include <tuple>
+#include <map>
+#include <set>
+#include <cmath>
+#include <atomic>
+
+#include "adjacency_list_graph.hpp"
+#include "adjacency_matrix_graph.hpp"
+#include "graph_generator.hpp"
+#include "dijkstra_algorithm.hpp"
+#include "dense_dijkstra.hpp"
+#include "delta_stepping.hpp"
+#include "bidirectional_dijkstra.hpp"
+#include "alt.hpp"
+#include "contraction_hierarchy.hpp"
+#include "dynamic_shortest_paths.hpp"
+#include "integer_dijkstra.hpp"
+#include "multi_source.hpp"
+#include "weight_traits.hpp"
+#include "graph_loader.hpp"
+#include "mapped_graph.hpp"
+
+// Testy porownujace algorytmy najkrotszych sciezek z DijkstraAlgorithm::shortestPath na losowych grafach
+// o stalym ziarnie. Program zwraca 0, jezeli wszystkie sprawdzenia zakonczyly sie powodzeniem.
+
+static int failures = 0;
+
+/// @brief Zapisuje niepowodzenie i wypisuje komunikat, jezeli warunek nie jest spelniony.
+/// @param condition sprawdzany warunek
+/// @param message opis sprawdzenia
+static void check(const bool& condition, const std::string& message)
+{
+    if (condition)
+        return;
+    if (failures < 20)
+        std::cerr << "FAIL: " << message << std::endl;
+    failures++;
+}
+
+/// @brief Losowy graf testowy z opisem uzywanym w komunikatach.
+struct TestGraph
+{
+    std::string name;
+    std::unique_ptr<GraphADT<int,int>> graph;
+};
+
+/// @brief Implementacje grafu sprawdzane w testach.
+enum class GraphKind { List, Matrix, CompactMatrix };
+
+/// @return Zwraca pusty graf danej implementacji.
+static std::unique_ptr<GraphADT<int,int>> makeGraph(const GraphKind& kind)
+{
+    if (kind == GraphKind::Matrix)
+        return std::unique_ptr<GraphADT<int,int>>(new AdjacencyMatrixGraph<int,int>());
+    if (kind == GraphKind::CompactMatrix)
+        return std::unique_ptr<GraphADT<int,int>>(new CompactAdjacencyMatrixGraph<int,int>());
+    return std::unique_ptr<GraphADT<int,int>>(new AdjacencyListGraph<int,int>());
+}
+
+/// @return Zwraca nazwe implementacji grafu uzywana w komunikatach.
+static std::string kindName(const GraphKind& kind)
+{
+    return kind == GraphKind::Matrix ? "matrix" : kind == GraphKind::CompactMatrix ? "compact matrix" : "list";
+}
+
+/// @return Zwraca grafy listowe i macierzowe (z komorkami wskaznikowymi i indeksowymi) o roznych rozmiarach,
+/// gestosciach i zakresach wag. Grafy rzadkie sa zwykle niespojne, a wagi bliskie INT_MAX sprawdzaja zachowanie
+/// przy przepelnieniu sumy.
+static std::vector<TestGraph> randomGraphs()
+{
+    std::vector<TestGraph> graphs;
+    GraphGenerator generator(2024);
+    for (int n : { 1, 2, 17, 64, 150 })
+        for (double density : { 0.02, 0.1, 0.5, 1.0 })
+            for (int maxWeight : { 100, INT_MAX - 1 })
+                for (GraphKind kind : { GraphKind::List, GraphKind::Matrix, GraphKind::CompactMatrix })
+                {
+                    TestGraph g;
+                    g.name = kindName(kind) + " n=" + std::to_string(n) + " d=" + std::to_string(density) + " w<=" + std::to_string(maxWeight);
+                    g.graph = makeGraph(kind);
+                    generator.simpleUndirected(g.graph.get(), n, density, 1, maxWeight);
+                    graphs.push_back(std::move(g));
+                }
+    return graphs;
+}
+
+/// @return Zwraca kilka wierzcholkow zrodlowych grafu (pierwszy, srodkowy i ostatni).
+static std::vector<sizeType> sources(const GraphADT<int,int>* graph)
+{
+    const sizeType n = graph->sizeV();
+    return { 0, n / 2, n - 1 };
+}
+
+/// @return Zwraca kopie grafu z wagami przeksztalconymi funkcja convert na typ W.
+template <typename W, typename F>
+static std::unique_ptr<GraphADT<int,W>> convertGraph(const GraphADT<int,int>* graph, const F& convert)
+{
+    std::unique_ptr<GraphADT<int,W>> result(new AdjacencyListGraph<int,W>());
+    for (sizeType i = 0; i < graph->sizeV(); i++)
+        result->insertVertex(graph->vertex(i)->element);
+    for (auto e : graph->edges())
+        result->insertEdge(result->vertex(e->v->i), result->vertex(e->w->i), convert(e->element));
+    return result;
+}
+
+/// @return Zwraca sume wag krawedzi kolejnych wierzcholkow sciezki albo -1, jezeli ktorejs krawedzi nie ma w grafie.
+static long long pathLength(const CSRGraph<int>& graph, const std::vector<sizeType>& path)
+{
+    long long length = 0;
+    for (sizeType k = 1; k < path.size(); k++)
+    {
+        long long best = -1;
+        for (sizeType e = graph.offset(path[k - 1]); e < graph.offset(path[k - 1] + 1); e++)
+            if (graph.target(e) == path[k] && (best < 0 || graph.weight(e) < best))
+                best = graph.weight(e);
+        if (best < 0)
+            return -1;
+        length += best;
+    }
+    return length;
+}
+
+/// @brief Sprawdza wynik zapytania punkt-punkt: dlugosc rowna odleglosci z DijkstraAlgorithm oraz sciezke
+/// od zrodla do celu po krawedziach grafu o lacznej wadze rownej tej dlugosci.
+static void checkPointToPoint(const CSRGraph<int>& graph, const sizeType& source, const sizeType& target, const int& expected,
+                              const PointToPointResult& result, const std::string& what)
+{
+    check(result.distance == expected, what + " distance");
+    if (expected == INT_MAX)
+    {
+        check(result.path.empty(), what + " path to unreachable target");
+        return;
+    }
+    check(!result.path.empty() && result.path.front() == source && result.path.back() == target, what + " path endpoints");
+    check(pathLength(graph, result.path) == expected, what + " path length");
+}
+
+/// @brief Sprawdza drzewo najkrotszych sciezek: odleglosci rowne expected oraz sciezki odtworzone z poprzednikow.
+static void checkTree(const ShortestPathTree& tree, const CSRGraph<int>& graph, const sizeType& source,
+                      const std::vector<int>& expected, const std::string& what)
+{
+    check(tree.source() == source && tree.sizeV() == graph.sizeV(), what + " source and size");
+    check(tree.distances() == expected, what + " distances");
+    check(tree.predecessor(source) == ShortestPathTree::NONE, what + " predecessor of source");
+    for (sizeType t = 0; t < graph.sizeV(); t++)
+    {
+        const std::string where = what + " target=" + std::to_string(t);
+        const std::vector<sizeType> path = tree.path(t);
+        check(tree.reachable(t) == (expected[t] != INT_MAX), where + " reachable");
+        if (expected[t] == INT_MAX)
+        {
+            check(path.empty() && tree.predecessor(t) == ShortestPathTree::NONE, where + " path to unreachable target");
+            continue;
+        }
+        check(!path.empty() && path.front() == source && path.back() == t, where + " path endpoints");
+        check(pathLength(graph, path) == expected[t], where + " path length");
+    }
+}
+
+static void testShortestPathTree(const std::vector<TestGraph>& graphs)
+{
+    check(ShortestPathTree().sizeV() == 0, "empty shortest path tree");
+    for (auto & g : graphs)
+    {
+        const CSRGraph<int> csr = g.graph->freeze();
+        for (sizeType s : sources(g.graph.get()))
+        {
+            const std::vector<int> expected = DijkstraAlgorithm::shortestPath(g.graph.get(), g.graph->vertex(s));
+            const std::string where = g.name + " source=" + std::to_string(s);
+            checkTree(DijkstraAlgorithm::shortestPathTree(g.graph.get(), g.graph->vertex(s)), csr, s, expected, "tree " + where);
+            checkTree(DijkstraAlgorithm::shortestPathTree(csr, s), csr, s, expected, "tree CSR " + where);
+            checkTree(DijkstraAlgorithm::shortestPathTree<PairingHeap>(csr, s), csr, s, expected, "tree CSR pairing " + where);
+        }
+    }
+}
+
+/// @brief Porownuje wersje tablicowa algorytmu Dijkstry z DijkstraAlgorithm dla kazdej wersji jader obslugiwanej
+/// przez procesor. Rozmiary grafow nie sa wielokrotnosciami szerokosci wektora, a grafy rzadkie sa niespojne.
+static void testDenseDijkstra(const std::vector<TestGraph>& graphs)
+{
+    const std::string selected = DenseDijkstraAlgorithm::simdPath();
+    check(!DenseDijkstraAlgorithm::forceSimdPath("unknown") && selected == DenseDijkstraAlgorithm::simdPath(), "dense unknown kernels");
+
+    GraphGenerator generator(31);
+    std::vector<TestGraph> matrices;
+    for (int n : { 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 33, 100 })
+        for (double density : { 0.0, 0.1, 0.5, 1.0 })
+            for (int maxWeight : { 100, INT_MAX - 1 })
+            {
+                TestGraph g;
+                g.name = "dense n=" + std::to_string(n) + " d=" + std::to_string(density) + " w<=" + std::to_string(maxWeight);
+                g.graph.reset(new AdjacencyMatrixGraph<int,int>());
+                generator.simpleUndirected(g.graph.get(), n, density, 1, maxWeight);
+                matrices.push_back(std::move(g));
+            }
+
+    const std::vector<TestGraph>* sets[] = { &matrices, &graphs };
+    for (const char* kernels : { "scalar", "sse4.1", "avx2" })
+    {
+        if (!DenseDijkstraAlgorithm::forceSimdPath(kernels))
+        {
+            std::cout << "DenseDijkstraAlgorithm: " << kernels << " not supported, skipped" << std::endl;
+            continue;
+        }
+        check(DenseDijkstraAlgorithm::simdPath() == std::string(kernels), std::string("dense forced ") + kernels);
+        for (const std::vector<TestGraph>* set : sets)
+            for (auto & g : *set)
+            {
+                const sizeType n = g.graph->sizeV();
+                std::vector<int> weights(n * n, INT_MAX);
+                for (auto e : g.graph->edges())
+                    weights[e->v->i * n + e->w->i] = weights[e->w->i * n + e->v->i] = e->element;
+                for (sizeType s : sources(g.graph.get()))
+                {
+                    const std::vector<int> expected = DijkstraAlgorithm::shortestPath(g.graph.get(), g.graph->vertex(s));
+                    const std::string where = std::string(kernels) + ' ' + g.name + " source=" + std::to_string(s);
+                    check(DenseDijkstraAlgorithm::shortestPath(g.graph.get(), g.graph->vertex(s)) == expected, "dense " + where);
+                    check(DenseDijkstraAlgorithm::shortestPath(weights.data(), n, s) == expected, "dense flat matrix " + where);
+                    check(DijkstraAlgorithm::shortestPathAuto(g.graph.get(), g.graph->vertex(s)) == expected, "auto " + where);
+                }
+            }
+    }
+    check(DenseDijkstraAlgorithm::forceSimdPath(selected), "dense restore kernels");
+}
+
+static void testDeltaStepping(const std::vector<TestGraph>& graphs)
+{
+    DeltaSteppingAlgorithm deltaStepping(4);
+    for (auto & g : graphs)
+    {
+        const CSRGraph<int> csr = g.graph->freeze();
+        for (sizeType s : sources(g.graph.get()))
+        {
+            const std::vector<int> expected = DijkstraAlgorithm::shortestPath(g.graph.get(), g.graph->vertex(s));
+            const std::string where = g.name + " source=" + std::to_string(s);
+            check(deltaStepping.shortestPath(g.graph.get(), g.graph->vertex(s)) == expected, "delta-stepping (auto delta) " + where);
+            check(deltaStepping.shortestPath(csr, s) == expected, "delta-stepping CSR (auto delta) " + where);
+            for (int delta : { 1, 37, INT_MAX / 2 })
+                check(deltaStepping.shortestPath(csr, s, delta) == expected, "delta-stepping delta=" + std::to_string(delta) + ' ' + where);
+        }
+    }
+}
+
+static void testBidirectional(const std::vector<TestGraph>& graphs)
+{
+    BidirectionalDijkstraAlgorithm<> bidirectional;
+    BidirectionalDijkstraAlgorithm<PairingHeap> pairing;
+    for (auto & g : graphs)
+    {
+        const CSRGraph<int> csr = g.graph->freeze();
+        for (sizeType s : sources(g.graph.get()))
+        {
+            const std::vector<int> expected = DijkstraAlgorithm::shortestPath(g.graph.get(), g.graph->vertex(s));
+            for (sizeType t = 0; t < csr.sizeV(); t++)
+            {
+                const std::string where = g.name + ' ' + std::to_string(s) + "->" + std::to_string(t);
+                checkPointToPoint(csr, s, t, expected[t], bidirectional.shortestPath(g.graph.get(), g.graph->vertex(s), g.graph->vertex(t)),
+                                  "bidirectional " + where);
+                checkPointToPoint(csr, s, t, expected[t], pairing.shortestPath(csr, s, t), "bidirectional CSR " + where);
+            }
+        }
+    }
+}
+
+/// @brief Sprawdza zapytania ALT dla wszystkich par (zrodlo, cel) ze zrodel testowych.
+template <typename A>
+static void checkALT(A& alt, const TestGraph& g, const CSRGraph<int>& csr, const std::string& what)
+{
+    for (sizeType s : sources(g.graph.get()))
+    {
+        const std::vector<int> expected = DijkstraAlgorithm::shortestPath(g.graph.get(), g.graph->vertex(s));
+        for (sizeType t = 0; t < csr.sizeV(); t++)
+        {
+            const std::string where = what + ' ' + g.name + ' ' + std::to_string(s) + "->" + std::to_string(t);
+            checkPointToPoint(csr, s, t, expected[t], alt.shortestPath(csr, s, t), where);
+            checkPointToPoint(csr, s, t, expected[t], alt.shortestPath(g.graph.get(), g.graph->vertex(s), g.graph->vertex(t)), where + " (GraphADT)");
+        }
+    }
+}
+
+static void testALT(const std::vector<TestGraph>& graphs)
+{
+    ThreadPool pool(4);
+    for (auto & g : graphs)
+    {
+        const CSRGraph<int> csr = g.graph->freeze();
+        for (auto selection : { LandmarkSelection::Random, LandmarkSelection::Farthest, LandmarkSelection::Avoid })
+        {
+            const std::string name = "ALT selection=" + std::to_string(static_cast<int>(selection));
+            ALTAlgorithm<> exact(pool);
+            exact.preprocess(csr, 4, selection, 7);
+            checkALT(exact, g, csr, name);
+
+            QuantisedALTAlgorithm<> quantised(pool);
+            quantised.preprocess(g.graph.get(), 4, selection, 7);
+            checkALT(quantised, g, csr, "quantised " + name);
+        }
+    }
+}
+
+/// @brief Sprawdza zapytania hierarchii dla wszystkich par (zrodlo, cel) ze zrodel testowych.
+static void checkHierarchy(ContractionHierarchy<>& hierarchy, const TestGraph& g, const CSRGraph<int>& csr, const std::string& what)
+{
+    for (sizeType s : sources(g.graph.get()))
+    {
+        const std::vector<int> expected = DijkstraAlgorithm::shortestPath(g.graph.get(), g.graph->vertex(s));
+        for (sizeType t = 0; t < csr.sizeV(); t++)
+            checkPointToPoint(csr, s, t, expected[t], hierarchy.shortestPath(s, t),
+                              what + ' ' + g.name + ' ' + std::to_string(s) + "->" + std::to_string(t));
+    }
+}
+
+static void testContractionHierarchy(const std::vector<TestGraph>& graphs)
+{
+    const std::string filePath = "shortest_paths_test.ch";
+    for (auto & g : graphs)
+    {
+        const CSRGraph<int> csr = g.graph->freeze();
+        // Niski prog zostawia duzy rdzen, a bardzo duzy kontraktuje caly graf, co dla grafow gestych trwa zbyt dlugo
+        const bool sparse = csr.sizeE() <= 0.05 * csr.sizeV() * csr.sizeV();
+        for (double coreDegree : { 2.0, 8.0, 32.0, 1e9 })
+        {
+            if (coreDegree > 32 && !sparse)
+                continue;
+            const std::string name = "CH core=" + std::to_string(coreDegree);
+            ContractionHierarchy<> hierarchy;
+            if (coreDegree == 32.0)
+                hierarchy.build(g.graph.get());
+            else
+                hierarchy.build(csr, coreDegree);
+            check(hierarchy.sizeV() == csr.sizeV(), name + " size " + g.name);
+            checkHierarchy(hierarchy, g, csr, name);
+
+            ContractionHierarchy<> loaded;
+            check(hierarchy.save(filePath), name + " save " + g.name);
+            check(loaded.load(filePath), name + " load " + g.name);
+            check(loaded.sizeE() == hierarchy.sizeE() && loaded.shortcuts() == hierarchy.shortcuts() && loaded.coreSize() == hierarchy.coreSize(),
+                  name + " loaded sizes " + g.name);
+            for (sizeType s : sources(g.graph.get()))
+                for (sizeType t = 0; t < csr.sizeV(); t++)
+                {
+                    const PointToPointResult a = hierarchy.shortestPath(s, t);
+                    const PointToPointResult b = loaded.shortestPath(s, t);
+                    check(a.distance == b.distance && a.path == b.path, name + " loaded query " + g.name);
+                }
+        }
+    }
+
+    // Plik obciety o jeden bajt musi zostac odrzucony
+    std::ifstream input(filePath, std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    input.close();
+    std::ofstream(filePath, std::ios::binary).write(data.data(), data.size() - 1);
+    ContractionHierarchy<> truncated;
+    check(!truncated.load(filePath) && truncated.sizeV() == 0, "CH load of truncated file");
+    check(!truncated.load(filePath + ".missing"), "CH load of missing file");
+    std::remove(filePath.c_str());
+}
+
+/// @return Zwraca krawedzie grafu jako posortowane trojki (mniejszy indeks, wiekszy indeks, waga).
+static std::vector<std::tuple<sizeType, sizeType, int>> edgeTriples(const GraphADT<int,int>* graph)
+{
+    std::vector<std::tuple<sizeType, sizeType, int>> edges;
+    for (auto e : graph->edges())
+        edges.emplace_back(std::min(e->v->i, e->w->i), std::max(e->v->i, e->w->i), e->element);
+    std::sort(edges.begin(), edges.end());
+    return edges;
+}
+
+/// @brief Sprawdza, czy wygenerowany graf jest prosty: brak petli i krawedzi wielokrotnych, wagi z przedzialu
+/// [minWeight, maxWeight], a wierzcholki dodane od indeksu first maja wartosci 1..n.
+static void checkGenerated(const GraphADT<int,int>* graph, const sizeType& first, const int& minWeight, const int& maxWeight,
+                           const std::string& what)
+{
+    bool values = true;
+    for (sizeType i = first; i < graph->sizeV(); i++)
+        values = values && graph->vertex(i)->element == static_cast<int>(i - first + 1);
+    check(values, what + " vertex values");
+    std::set<std::pair<sizeType, sizeType>> pairs;
+    bool simple = true;
+    bool weights = true;
+    for (auto e : graph->edges())
+    {
+        simple = simple && e->v != e->w && pairs.insert({ std::min(e->v->i, e->w->i), std::max(e->v->i, e->w->i) }).second;
+        weights = weights && e->element >= minWeight && e->element <= maxWeight;
+    }
+    check(simple, what + " no loops or duplicate edges");
+    check(weights, what + " weights in range");
+}
+
+static void testGraphGenerator()
+{
+    // Dokladna liczba krawedzi simpleUndirected, w tym dopelnienie dla gestosci ponad 1/2 i tablica mieszajaca
+    // dla bardzo rzadkich grafow
+    for (int n : { 1, 2, 10, 101, 2000 })
+        for (double density : { 0.0, 0.001, 0.3, 0.5, 0.51, 0.9, 1.0 })
+        {
+            if (n == 2000 && density > 0.01)
+                continue;
+            const std::string what = "generator simpleUndirected n=" + std::to_string(n) + " d=" + std::to_string(density);
+            AdjacencyListGraph<int,int> graph;
+            GraphGenerator generator(11);
+            generator.simpleUndirected(&graph, n, density, 5, 9);
+            check(graph.sizeV() == static_cast<sizeType>(n), what + " vertices");
+            check(graph.sizeE() == static_cast<sizeType>(density * n * (n - 1) / 2), what + " edge count");
+            checkGenerated(&graph, 0, 5, 9, what);
+        }
+
+    // G(n, p): liczba krawedzi w granicach pieciu odchylen standardowych od wartosci oczekiwanej
+    for (double p : { 0.0, 0.01, 0.2, 0.7, 1.0 })
+    {
+        const int n = 400;
+        const std::string what = "generator gnp p=" + std::to_string(p);
+        AdjacencyListGraph<int,int> graph;
+        GraphGenerator generator(12);
+        generator.gnp(&graph, n, p, 1, 100);
+        const double pairs = n * (n - 1) / 2.0;
+        const double deviation = std::sqrt(pairs * p * (1 - p));
+        check(graph.sizeV() == static_cast<sizeType>(n), what + " vertices");
+        check(std::abs(static_cast<double>(graph.sizeE()) - pairs * p) <= 5 * deviation + 0.5, what + " edge count");
+        checkGenerated(&graph, 0, 1, 100, what);
+    }
+
+    // Barabasi-Albert: klika m + 1 wierzcholkow, potem m krawedzi na wierzcholek; kazdy stopien wynosi co najmniej m
+    for (int m : { 1, 3, 8 })
+    {
+        const int n = 300;
+        const std::string what = "generator barabasiAlbert m=" + std::to_string(m);
+        AdjacencyListGraph<int,int> graph;
+        GraphGenerator generator(13);
+        generator.barabasiAlbert(&graph, n, m, 1, 100);
+        check(graph.sizeE() == static_cast<sizeType>(m * (m + 1) / 2 + (n - m - 1) * m), what + " edge count");
+        bool degrees = true;
+        for (sizeType i = 0; i < graph.sizeV(); i++)
+            degrees = degrees && graph.incidentEdges(graph.vertex(i)).size() >= static_cast<sizeType>(m);
+        check(degrees, what + " degrees");
+        checkGenerated(&graph, 0, 1, 100, what);
+    }
+
+    // Siatka: krawedzie tylko do sasiada z prawej i z dolu
+    for (auto size : { std::make_pair(1, 1), std::make_pair(1, 7), std::make_pair(6, 9) })
+    {
+        const int rows = size.first;
+        const int cols = size.second;
+        const std::string what = "generator grid " + std::to_string(rows) + "x" + std::to_string(cols);
+        AdjacencyListGraph<int,int> graph;
+        GraphGenerator generator(14);
+        generator.grid(&graph, rows, cols, 1, 100);
+        check(graph.sizeE() == static_cast<sizeType>(rows * (cols - 1) + cols * (rows - 1)), what + " edge count");
+        bool neighbours = true;
+        for (auto & e : edgeTriples(&graph))
+        {
+            const sizeType a = std::get<0>(e);
+            const sizeType b = std::get<1>(e);
+            neighbours = neighbours && ((b == a + 1 && b % cols != 0) || b == a + static_cast<sizeType>(cols));
+        }
+        check(neighbours, what + " neighbours");
+        checkGenerated(&graph, 0, 1, 100, what);
+    }
+
+    // To samo ziarno daje ten sam graf (takze po seed()), a inne ziarno inny; wierzcholki dopisywane sa za istniejacymi
+    auto generate = [](GraphGenerator& generator, GraphADT<int,int>* graph, const int& model)
+    {
+        if (model == 0)
+            generator.simpleUndirected(graph, 80, 0.2, 1, 1000);
+        else if (model == 1)
+            generator.simpleUndirected(graph, 80, 0.8, 1, 1000);
+        else if (model == 2)
+            generator.gnp(graph, 80, 0.1, 1, 1000);
+        else if (model == 3)
+            generator.barabasiAlbert(graph, 80, 3, 1, 1000);
+        else
+            generator.grid(graph, 8, 10, 1, 1000);
+    };
+    for (int model = 0; model < 5; model++)
+    {
+        const std::string what = "generator model=" + std::to_string(model);
+        AdjacencyListGraph<int,int> a, b, c, d;
+        GraphGenerator first(77), second(77), other(78);
+        generate(first, &a, model);
+        generate(second, &b, model);
+        generate(other, &c, model);
+        check(first.seed() == 77 && edgeTriples(&a) == edgeTriples(&b), what + " same seed");
+        check(edgeTriples(&a) != edgeTriples(&c), what + " different seed");
+        other.seed(77);
+        generate(other, &d, model);
+        check(other.seed() == 77 && edgeTriples(&a) == edgeTriples(&d), what + " reseeded");
+
+        AdjacencyMatrixGraph<int,int> appended;
+        GraphGenerator again(77);
+        appended.insertVertex(0);
+        appended.insertVertex(0);
+        generate(again, &appended, model);
+        bool shifted = appended.sizeV() == a.sizeV() + 2 && appended.sizeE() == a.sizeE();
+        const auto expected = edgeTriples(&a);
+        const auto actual = edgeTriples(&appended);
+        for (sizeType k = 0; shifted && k < expected.size(); k++)
+            shifted = std::get<0>(actual[k]) == std::get<0>(expected[k]) + 2 && std::get<1>(actual[k]) == std::get<1>(expected[k]) + 2 &&
+                      std::get<2>(actual[k]) == std::get<2>(expected[k]);
+        check(shifted, what + " appended to a non-empty graph");
+        checkGenerated(&appended, 2, 1, 1000, what + " appended");
+    }
+}
+
+/// @brief Model grafu: wagi krawedzi indeksowane parami wartosci wierzcholkow (mniejsza, wieksza).
+typedef std::map<std::pair<int, int>, int> EdgeModel;
+
+/// @return Zwraca klucz modelu dla krawedzi miedzy wierzcholkami o wartosciach a i b.
+static std::pair<int, int> edgeKey(const int& a, const int& b)
+{
+    return { std::min(a, b), std::max(a, b) };
+}
+
+/// @brief Sprawdza spojnosc grafu z modelem: liczby wierzcholkow i krawedzi, indeksy, sasiedztwo kazdej pary
+/// oraz krawedzie incydentne kazdego wierzcholka (w obu wersjach incidentEdges).
+static void checkAgainstModel(const GraphADT<int,int>* graph, const std::vector<int>& values, const EdgeModel& model, const std::string& what)
+{
+    check(graph->sizeV() == values.size() && graph->sizeE() == model.size(), what + " sizes");
+    bool indices = true;
+    for (sizeType i = 0; i < graph->sizeV(); i++)
+        indices = indices && graph->vertex(i)->i == i && graph->vertex(i)->element == values[i];
+    for (sizeType i = 0; i < graph->sizeE(); i++)
+        indices = indices && graph->edge(i)->i == i;
+    check(indices, what + " indices");
+
+    bool adjacency = true;
+    bool incidence = true;
+    for (sizeType i = 0; i < graph->sizeV(); i++)
+    {
+        const Vertex<int,int>* v = graph->vertex(i);
+        for (sizeType j = 0; j < graph->sizeV(); j++)
+            if (i != j && graph->areAdjacent(v, graph->vertex(j)) != (model.count(edgeKey(values[i], values[j])) > 0))
+                adjacency = false;
+
+        sizeType degree = 0;
+        for (auto & entry : model)
+            degree += entry.first.first == values[i] || entry.first.second == values[i];
+        const std::vector<Edge<int,int>*> incident = graph->incidentEdges(v);
+        sizeType ranged = 0;
+        for (auto e : graph->incidentEdgesRange(v))
+        {
+            ranged++;
+            incidence = incidence && (e->v == v || e->w == v);
+        }
+        incidence = incidence && incident.size() == degree && ranged == degree;
+        for (auto e : incident)
+        {
+            const auto found = model.find(edgeKey(v->element, graph->opposite(v, e)->element));
+            incidence = incidence && found != model.end() && found->second == e->element;
+        }
+    }
+    check(adjacency, what + " areAdjacent");
+    check(incidence, what + " incident edges");
+}
+
+static void testGraphRemovals()
+{
+    GraphGenerator generator(17);
+    std::mt19937 engine(17);
+    for (GraphKind kind : { GraphKind::List, GraphKind::Matrix, GraphKind::CompactMatrix })
+        for (double density : { 0.1, 0.5, 1.0 })
+        {
+            std::unique_ptr<GraphADT<int,int>> graph = makeGraph(kind);
+            generator.simpleUndirected(graph.get(), 40, density, 1, 1000);
+            const std::string name = "removals " + kindName(kind) + " d=" + std::to_string(density);
+            std::vector<int> values;
+            for (sizeType i = 0; i < graph->sizeV(); i++)
+                values.push_back(graph->vertex(i)->element);
+            EdgeModel model;
+            for (auto e : graph->edges())
+                model[edgeKey(e->v->element, e->w->element)] = e->element;
+            checkAgainstModel(graph.get(), values, model, name + " initial");
+
+            for (int step = 0; step < 30 && graph->sizeV() > 0; step++)
+            {
+                const std::string where = name + " step=" + std::to_string(step);
+                const int operation = step % 3;
+                if (operation == 0 && graph->sizeE() > 0)
+                {
+                    // Kilka losowych krawedzi naraz, w tym ostatnia, ktora zwykle jest przenoszona
+                    std::vector<Edge<int,int>*> chosen = graph->edges();
+                    std::shuffle(chosen.begin(), chosen.end(), engine);
+                    chosen.resize(std::min<sizeType>(chosen.size(), 5));
+                    if (std::find(chosen.begin(), chosen.end(), graph->edge(graph->sizeE() - 1)) == chosen.end())
+                        chosen.back() = graph->edge(graph->sizeE() - 1);
+                    for (auto e : chosen)
+                        model.erase(edgeKey(e->v->element, e->w->element));
+                    graph->removeEdges(chosen);
+                    checkAgainstModel(graph.get(), values, model, where + " removeEdges");
+                }
+                else if (operation == 1 && graph->sizeE() > 0)
+                {
+                    Edge<int,int>* e = graph->edge(std::uniform_int_distribution<sizeType>(0, graph->sizeE() - 1)(engine));
+                    model.erase(edgeKey(e->v->element, e->w->element));
+                    graph->removeEdge(e);
+                    checkAgainstModel(graph.get(), values, model, where + " removeEdge");
+                }
+                else
+                {
+                    // Ostatni wierzcholek przejmuje indeks usunietego razem z krawedziami incydentnymi
+                    const sizeType k = step % 2 ? graph->sizeV() - 1 : std::uniform_int_distribution<sizeType>(0, graph->sizeV() - 1)(engine);
+                    const int removed = values[k];
+                    for (auto it = model.begin(); it != model.end();)
+                        it = it->first.first == removed || it->first.second == removed ? model.erase(it) : std::next(it);
+                    values[k] = values.back();
+                    values.pop_back();
+                    graph->removeVertex(graph->vertex(k));
+                    check(k == graph->sizeV() || graph->vertex(k)->element == values[k], where + " moved vertex");
+                    checkAgainstModel(graph.get(), values, model, where + " removeVertex");
+
+                    // Nowa krawedz przeniesionego wierzcholka musi trafic do jego nowego wiersza macierzy
+                    if (k < graph->sizeV() && graph->sizeV() > 1)
+                    {
+                        Vertex<int,int>* moved = graph->vertex(k);
+                        for (sizeType j = 0; j < graph->sizeV(); j++)
+                            if (j != k && !graph->areAdjacent(moved, graph->vertex(j)))
+                            {
+                                graph->insertEdge(moved, graph->vertex(j), 7);
+                                model[edgeKey(values[k], values[j])] = 7;
+                                break;
+                            }
+                        checkAgainstModel(graph.get(), values, model, where + " insertEdge after move");
+                    }
+                }
+            }
+        }
+}
+
+/// @brief Sprawdza, czy odleglosci utrzymywane przyrostowo sa rowne wyznaczonym od nowa.
+static void checkDynamic(const DynamicShortestPaths<int>& dynamic, const GraphADT<int,int>* graph, const std::string& what)
+{
+    if (dynamic.source() == ShortestPathTree::NONE)
+    {
+        check(std::all_of(dynamic.distances().begin(), dynamic.distances().end(), [](int d) { return d == INT_MAX; }),
+              what + " distances after source removal");
+        return;
+    }
+    const std::vector<int> expected = DijkstraAlgorithm::shortestPath(graph, graph->vertex(dynamic.source()));
+    check(dynamic.distances() == expected, what + " distances");
+    check(dynamic.tree().distances() == expected && dynamic.distance(dynamic.source()) == 0, what + " tree");
+}
+
+static void testDynamicShortestPaths()
+{
+    GraphGenerator generator(99);
+    std::mt19937 engine(99);
+    for (int n : { 2, 17, 64 })
+        for (double density : { 0.05, 0.3 })
+            for (int maxWeight : { 100, INT_MAX - 1 })
+                for (GraphKind kind : { GraphKind::List, GraphKind::Matrix, GraphKind::CompactMatrix })
+                {
+                    std::unique_ptr<GraphADT<int,int>> graph = makeGraph(kind);
+                    generator.simpleUndirected(graph.get(), n, density, 1, maxWeight);
+                    const std::string name = "dynamic " + kindName(kind) + " n=" + std::to_string(n)
+                                           + " d=" + std::to_string(density) + " w<=" + std::to_string(maxWeight);
+
+                    DynamicShortestPaths<int> dynamic(graph.get(), graph->vertex(n / 2));
+                    checkDynamic(dynamic, graph.get(), name + " initial");
+                    std::uniform_int_distribution<int> weight(1, maxWeight);
+                    for (int step = 0; step < 300 && dynamic.source() != ShortestPathTree::NONE; step++)
+                    {
+                        const std::string where = name + " step=" + std::to_string(step);
+                        const sizeType vertices = graph->sizeV();
+                        const int operation = std::uniform_int_distribution<int>(0, 99)(engine);
+                        if (operation < 40 && graph->sizeE() > 0)
+                        {
+                            // Losowa nowa waga skraca albo wydluza krawedz
+                            Edge<int,int>* e = graph->edge(std::uniform_int_distribution<sizeType>(0, graph->sizeE() - 1)(engine));
+                            graph->replace(e, weight(engine));
+                            checkDynamic(dynamic, graph.get(), where + " replace");
+                        }
+                        else if (operation < 60 && graph->sizeE() > 0)
+                        {
+                            graph->removeEdge(graph->edge(std::uniform_int_distribution<sizeType>(0, graph->sizeE() - 1)(engine)));
+                            checkDynamic(dynamic, graph.get(), where + " removeEdge");
+                        }
+                        else if (operation < 90 && vertices > 1)
+                        {
+                            std::uniform_int_distribution<sizeType> pick(0, vertices - 1);
+                            Vertex<int,int>* v = graph->vertex(pick(engine));
+                            Vertex<int,int>* w = graph->vertex(pick(engine));
+                            if (v == w || graph->areAdjacent(v, w))
+                                continue;
+                            graph->insertEdge(v, w, weight(engine));
+                            checkDynamic(dynamic, graph.get(), where + " insertEdge");
+                        }
+                        else if (operation < 95)
+                        {
+                            Vertex<int,int>* v = graph->insertVertex(static_cast<int>(vertices));
+                            check(dynamic.distances().size() == graph->sizeV(), where + " insertVertex size");
+                            checkDynamic(dynamic, graph.get(), where + " insertVertex");
+                            graph->insertEdge(graph->vertex(dynamic.source()), v, weight(engine));
+                            checkDynamic(dynamic, graph.get(), where + " insertEdge to new vertex");
+                        }
+                        else
+                        {
+                            // Usuniecie wierzcholka przenosi ostatni wierzcholek na zwolniony indeks, takze gdy jest nim zrodlo
+                            const sizeType i = std::uniform_int_distribution<sizeType>(0, vertices - 1)(engine);
+                            const bool sourceRemoved = i == dynamic.source();
+                            graph->removeVertex(graph->vertex(i));
+                            check(dynamic.distances().size() == graph->sizeV(), where + " removeVertex size");
+                            check(sourceRemoved == (dynamic.source() == ShortestPathTree::NONE), where + " removeVertex source");
+                            checkDynamic(dynamic, graph.get(), where + " removeVertex");
+                        }
+                    }
+                }
+
+    // Wyczyszczenie grafu usuwa zrodlo, a zniszczenie grafu odlacza obserwatora
+    std::unique_ptr<GraphADT<int,int>> graph(new AdjacencyListGraph<int,int>());
+    generator.simpleUndirected(graph.get(), 10, 0.5, 1, 100);
+    DynamicShortestPaths<int> dynamic(graph.get(), graph->vertex(0));
+    graph->clear();
+    check(dynamic.source() == ShortestPathTree::NONE && dynamic.distances().empty(), "dynamic after clear");
+    graph.reset();
+    check(dynamic.source() == ShortestPathTree::NONE, "dynamic after graph destruction");
+}
+
+/// @return Zwraca odleglosci z DijkstraAlgorithm na kopii grafu o wagach long long, zapisane tak jak w IntegerDijkstraAlgorithm.
+static std::vector<std::uint64_t> exactDistances(const GraphADT<int,int>* graph, const sizeType& source)
+{
+    const std::unique_ptr<GraphADT<int,long long>> wide = convertGraph<long long>(graph, [](int x) { return static_cast<long long>(x); });
+    const std::vector<long long> D = DijkstraAlgorithm::shortestPath(wide.get(), wide->vertex(source));
+    std::vector<std::uint64_t> result(D.size());
+    for (sizeType i = 0; i < D.size(); i++)
+        result[i] = D[i] == LLONG_MAX ? IntegerDijkstraAlgorithm::INF : static_cast<std::uint64_t>(D[i]);
+    return result;
+}
+
+static void testIntegerDijkstra(const std::vector<TestGraph>& graphs)
+{
+    static_assert(!IntegerDijkstraAlgorithm::Queue<int,0>::dial, "wagi int wybieraja kopiec pozycyjny");
+    static_assert(IntegerDijkstraAlgorithm::Queue<int,100>::dial, "podpowiedz 100 wybiera kubelki Diala");
+    static_assert(IntegerDijkstraAlgorithm::Queue<std::uint8_t,0>::dial, "wagi uint8_t wybieraja kubelki Diala");
+    static_assert(!IntegerDijkstraAlgorithm::Queue<std::uint16_t,0>::dial, "wagi uint16_t wybieraja kopiec pozycyjny");
+    for (auto & g : graphs)
+    {
+        const CSRGraph<int> csr = g.graph->freeze();
+        int maxWeight = 0;
+        for (auto e : g.graph->edges())
+            maxWeight = std::max(maxWeight, e->element);
+        for (sizeType s : sources(g.graph.get()))
+        {
+            const std::vector<std::uint64_t> expected = exactDistances(g.graph.get(), s);
+            const std::string where = g.name + " source=" + std::to_string(s);
+            check(IntegerDijkstraAlgorithm::shortestPath(g.graph.get(), g.graph->vertex(s)) == expected, "integer radix " + where);
+            check(IntegerDijkstraAlgorithm::shortestPath(csr, s) == expected, "integer radix CSR " + where);
+            if (maxWeight > 100)
+                continue;
+
+            check(IntegerDijkstraAlgorithm::shortestPath<100>(g.graph.get(), g.graph->vertex(s)) == expected, "integer Dial " + where);
+            check(IntegerDijkstraAlgorithm::shortestPath<100>(csr, s) == expected, "integer Dial CSR " + where);
+            check(IntegerDijkstraAlgorithm::shortestPath<IntegerDijkstraAlgorithm::DIAL_LIMIT>(csr, s) == expected,
+                  "integer Dial (limit) CSR " + where);
+
+            const auto narrow = convertGraph<std::uint8_t>(g.graph.get(), [](int x) { return static_cast<std::uint8_t>(x); });
+            check(IntegerDijkstraAlgorithm::shortestPath(narrow.get(), narrow->vertex(s)) == expected, "integer Dial uint8_t " + where);
+            const auto medium = convertGraph<std::uint16_t>(g.graph.get(), [](int x) { return static_cast<std::uint16_t>(x); });
+            check(IntegerDijkstraAlgorithm::shortestPath(medium->freeze(), s) == expected, "integer radix uint16_t CSR " + where);
+        }
+    }
+}
+
+/// @brief Sprawdza DijkstraAlgorithm::shortestPath i drzewo najkrotszych sciezek dla kopii grafu o wagach typu W
+/// wzgledem dokladnych odleglosci przeksztalconych funkcja expect.
+template <typename W, typename F, typename E>
+static void checkWeights(const TestGraph& g, const F& convert, const E& expect, const std::string& what)
+{
+    const std::unique_ptr<GraphADT<int,W>> graph = convertGraph<W>(g.graph.get(), convert);
+    const CSRGraph<W> csr = graph->freeze();
+    for (sizeType s : sources(g.graph.get()))
+    {
+        const std::vector<std::uint64_t> exact = exactDistances(g.graph.get(), s);
+        std::vector<W> expected(exact.size());
+        for (sizeType i = 0; i < exact.size(); i++)
+            expected[i] = expect(exact[i]);
+        const std::string where = what + ' ' + g.name + " source=" + std::to_string(s);
+        check(DijkstraAlgorithm::shortestPath(graph.get(), graph->vertex(s)) == expected, where);
+        check(DijkstraAlgorithm::shortestPath(csr, s) == expected, where + " CSR");
+        check(DijkstraAlgorithm::shortestPath<QuaternaryHeap>(csr, s) == expected, where + " CSR quaternary");
+        check(DijkstraAlgorithm::shortestPathTree(csr, s).distances() == expected, where + " tree");
+    }
+}
+
+static void testGenericWeights(const std::vector<TestGraph>& graphs)
+{
+    ThreadPool pool(4);
+    for (auto & g : graphs)
+    {
+        int maxWeight = 0;
+        for (auto e : g.graph->edges())
+            maxWeight = std::max(maxWeight, e->element);
+
+        // Sumy wag uint32_t nasycaja sie na najwiekszej wartosci, ktora oznacza wierzcholek nieosiagalny
+        checkWeights<std::uint32_t>(g, [](int x) { return static_cast<std::uint32_t>(x); },
+                                    [](std::uint64_t d) { return static_cast<std::uint32_t>(std::min<std::uint64_t>(d, UINT32_MAX)); },
+                                    "uint32_t");
+        if (maxWeight > 100)
+            continue;
+
+        // Odleglosci sa calkowite i mniejsze niz 2^24, wiec float reprezentuje je dokladnie
+        checkWeights<float>(g, [](int x) { return static_cast<float>(x); },
+                            [](std::uint64_t d) { return d == IntegerDijkstraAlgorithm::INF ? WeightTraits<float>::infinity() : static_cast<float>(d); },
+                            "float");
+        // Wagi x/4 sa dokladne w FixedPoint<16>, wiec odleglosc d/4 ma wartosc surowa d * 2^14
+        typedef FixedPoint<16> Fixed;
+        checkWeights<Fixed>(g, [](int x) { return Fixed(x / 4.0); },
+                            [](std::uint64_t d) { return d == IntegerDijkstraAlgorithm::INF ? WeightTraits<Fixed>::infinity()
+                                                                                              : Fixed::fromRaw(static_cast<std::int32_t>(d << 14)); },
+                            "FixedPoint<16>");
+
+        // Macierz odleglosci float z wielu zrodel zgadza sie z pojedynczymi zapytaniami
+        const std::unique_ptr<GraphADT<int,float>> graph = convertGraph<float>(g.graph.get(), [](int x) { return static_cast<float>(x); });
+        const CSRGraph<float> csr = graph->freeze();
+        BasicMultiSourceShortestPaths<float> multiSource(pool);
+        const std::vector<float> matrix = multiSource.allPairs(csr.view());
+        bool same = matrix.size() == csr.sizeV() * csr.sizeV();
+        for (sizeType s = 0; same && s < csr.sizeV(); s++)
+            same = std::equal(matrix.begin() + s * csr.sizeV(), matrix.begin() + (s + 1) * csr.sizeV(),
+                              DijkstraAlgorithm::shortestPath(csr, s).begin());
+        check(same, "float all pairs " + g.name);
+    }
+}
+
+/// @return Zwraca krawedzie migawki jako posortowane trojki (u, v, w) z u < v.
+static std::vector<std::tuple<sizeType, sizeType, int>> edgeSet(const CSRView<int>& graph)
+{
+    std::vector<std::tuple<sizeType, sizeType, int>> edges;
+    for (sizeType v = 0; v < graph.sizeV(); v++)
+        for (sizeType k = graph.offset(v); k < graph.offset(v + 1); k++)
+            if (graph.target(k) > v)
+                edges.emplace_back(v, graph.target(k), graph.weight(k));
+    std::sort(edges.begin(), edges.end());
+    return edges;
+}
+
+/// @brief Zapisuje tekst do pliku bez zadnych przeksztalcen znakow konca wiersza.
+static void writeFile(const std::string& filePath, const std::string& text)
+{
+    std::ofstream(filePath, std::ios::binary) << text;
+}
+
+/// @brief Wczytuje plik wszystkimi wersjami GraphLoader::load i sprawdza, czy wyniki sa zgodne z oczekiwanym grafem
+/// albo, dla expected == nullptr, czy plik zostal odrzucony.
+static void checkLoad(const std::string& filePath, const GraphFormat& format, const CSRGraph<int>* expected, const std::string& what)
+{
+    ThreadPool pool(4);
+    for (sizeType chunkSize : { sizeType(1), sizeType(3), sizeType(7), sizeType(64), GraphLoader::CHUNK_SIZE })
+    {
+        const std::string where = what + " chunk=" + std::to_string(chunkSize);
+        GraphLoader loader(pool, chunkSize);
+        CSRGraph<int> csr;
+        const bool loaded = loader.load(filePath, format, csr);
+        CSRBuilder<int> builder;
+        const bool built = loader.load(filePath, format, builder);
+        AdjacencyListGraph<int,int> graph;
+        const bool inserted = loader.load(filePath, format, &graph);
+        if (!expected)
+        {
+            check(!loaded && !built && !inserted && graph.sizeV() == 0, where + " rejected");
+            continue;
+        }
+        check(loaded && built && inserted, where + " loaded");
+        const auto edges = edgeSet(*expected);
+        check(csr.sizeV() == expected->sizeV() && csr.sizeE() == expected->sizeE() && edgeSet(csr) == edges, where + " CSR");
+        const CSRGraph<int> fromBuilder = builder.build();
+        check(fromBuilder.sizeV() == expected->sizeV() && edgeSet(fromBuilder) == edges, where + " builder");
+        const CSRGraph<int> fromGraph = graph.freeze();
+        check(graph.sizeV() == expected->sizeV() && edgeSet(fromGraph) == edges, where + " GraphADT");
+    }
+}
+
+static void testGraphLoader()
+{
+    const std::string filePath = "shortest_paths_test.graph";
+    check(GraphLoader::detect("road.gr") == GraphFormat::DIMACS && GraphLoader::detect("web.txt") == GraphFormat::SNAP, "loader detect");
+
+    // Oba kierunki luku i powtorzenie zostawiaja najmniejsza wage, a petla jest pomijana
+    const CSRGraph<int> small(std::vector<sizeType>{ 0, 1, 3, 4, 4, 4 }, std::vector<std::uint32_t>{ 1, 0, 2, 1 },
+                              std::vector<int>{ 3, 3, 7, 7 });
+    const std::string dimacs = "c comment\np sp 5 4\na 1 2 5\na 2 1 3\n\na 2 3 7\na 3 3 1\n";
+    writeFile(filePath, dimacs);
+    checkLoad(filePath, GraphFormat::DIMACS, &small, "DIMACS");
+    std::string crlf;
+    for (char c : dimacs)
+        crlf += c == '\n' ? std::string("\r\n") : std::string(1, c);
+    writeFile(filePath, crlf);
+    checkLoad(filePath, GraphFormat::DIMACS, &small, "DIMACS CRLF");
+    writeFile(filePath, "p sp 5 4\na 1 2 3\na 2 3 7");
+    checkLoad(filePath, GraphFormat::DIMACS, &small, "DIMACS without final newline");
+    writeFile(filePath, "# comment\n0 1 3\n1 2 7\r\n% other comment\n1 0 9\n4 4");
+    checkLoad(filePath, GraphFormat::SNAP, &small, "SNAP");
+    const CSRGraph<int> unweighted(std::vector<sizeType>{ 0, 1, 2 }, std::vector<std::uint32_t>{ 1, 0 }, std::vector<int>{ 1, 1 });
+    writeFile(filePath, "0\t1\n");
+    checkLoad(filePath, GraphFormat::SNAP, &unweighted, "SNAP default weight");
+
+    // Naglowek niezgodny z lukami i niepoprawne wiersze
+    for (const char* text : { "p sp 2 1\na 1 3 5\n", "p sp 0 0\n", "p sp 3\n", "a 1 2\n", "a 1 2 x\n", "a 0 1 5\n",
+                              "a 1 2 3 4\n", "e 1 2 3\n", "a 1 2 2147483648\n", "a 1 2 -3\n", "a 1 2 99999999999999999999999\n" })
+    {
+        writeFile(filePath, text);
+        checkLoad(filePath, GraphFormat::DIMACS, nullptr, std::string("DIMACS malformed '") + text + "'");
+    }
+    for (const char* text : { "0\n", "0 1 2 3\n", "0 x\n", "-1 2\n", "0 1 2147483648\n", "0 4294967295\n" })
+    {
+        writeFile(filePath, text);
+        checkLoad(filePath, GraphFormat::SNAP, nullptr, std::string("SNAP malformed '") + text + "'");
+    }
+    checkLoad(filePath + ".missing", GraphFormat::SNAP, nullptr, "missing file");
+
+    // Losowy graf zapisany w obu formatach
+    GraphGenerator generator(5);
+    AdjacencyListGraph<int,int> graph;
+    generator.simpleUndirected(&graph, 300, 0.05, 1, INT_MAX - 1);
+    const CSRGraph<int> expected = graph.freeze();
+    std::string dimacsText = "p sp " + std::to_string(graph.sizeV()) + ' ' + std::to_string(graph.sizeE()) + '\n';
+    std::string snapText;
+    for (auto e : graph.edges())
+    {
+        dimacsText += "a " + std::to_string(e->v->i + 1) + ' ' + std::to_string(e->w->i + 1) + ' ' + std::to_string(e->element) + '\n';
+        snapText += std::to_string(e->w->i) + ' ' + std::to_string(e->v->i) + ' ' + std::to_string(e->element) + '\n';
+    }
+    snapText += std::to_string(graph.sizeV() - 1) + ' ' + std::to_string(graph.sizeV() - 1) + '\n';
+    writeFile(filePath, dimacsText);
+    checkLoad(filePath, GraphFormat::DIMACS, &expected, "DIMACS random");
+    writeFile(filePath, snapText);
+    checkLoad(filePath, GraphFormat::SNAP, &expected, "SNAP random");
+    std::remove(filePath.c_str());
+}
+
+/// @return Zwraca zawartosc pliku binarnego.
+static std::string readFile(const std::string& filePath)
+{
+    std::ifstream input(filePath, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+}
+
+/// @brief Zapisuje kopie pliku z wartoscia X pod danym przesunieciem.
+template <typename X>
+static void patchFile(const std::string& source, const std::string& filePath, const sizeType& position, const X& value)
+{
+    std::string data = readFile(source);
+    std::memcpy(&data[position], &value, sizeof(X));
+    writeFile(filePath, data);
+}
+
+/// @return Zwraca prawde, jezeli widoki maja identyczne tablice przesuniec, sasiadow i wag.
+static bool sameView(const CSRView<int>& a, const CSRView<int>& b)
+{
+    if (a.sizeV() != b.sizeV() || a.sizeE() != b.sizeE())
+        return false;
+    for (sizeType v = 0; v <= a.sizeV() && a.sizeV() > 0; v++)
+        if (a.offset(v) != b.offset(v))
+            return false;
+    for (sizeType k = 0; k < a.sizeE(); k++)
+        if (a.target(k) != b.target(k) || a.weight(k) != b.weight(k))
+            return false;
+    return true;
+}
+
+static void testMappedGraph(const std::vector<TestGraph>& graphs)
+{
+    const std::string filePath = "shortest_paths_test.csr";
+    const std::string patchedPath = filePath + ".patched";
+    DeltaSteppingAlgorithm deltaStepping(2);
+    BidirectionalDijkstraAlgorithm<> bidirectional;
+    ThreadPool pool(2);
+    ALTAlgorithm<> alt(pool);
+    for (auto & g : graphs)
+    {
+        const CSRGraph<int> csr = g.graph->freeze();
+        for (bool payloads : { true, false })
+        {
+            const std::string where = "mapped " + g.name + (payloads ? " with payloads" : " without payloads");
+            check(MappedGraph<int,int>::save(g.graph.get(), filePath, payloads), where + " save");
+            MappedGraph<int,int> mapped;
+            check(mapped.open(filePath) && mapped.isOpen() && mapped.validate(), where + " open");
+            check(sameView(mapped.view(), csr.view()) && mapped.sizeV() == csr.sizeV() && mapped.sizeE() == csr.sizeE(), where + " view");
+            check(mapped.hasPayloads() == payloads, where + " payloads flag");
+            bool samePayloads = true;
+            for (sizeType i = 0; payloads && i < mapped.sizeV(); i++)
+                samePayloads = samePayloads && mapped.payload(i) == g.graph->vertex(i)->element;
+            check(samePayloads, where + " payloads");
+
+            // Widok odwzorowanego pliku przekazywany jest do algorytmow bez kopiowania
+            MappedGraph<int,int> moved(std::move(mapped));
+            check(!mapped.isOpen() && moved.isOpen(), where + " move");
+            alt.preprocess(moved, 4, LandmarkSelection::Avoid, 7);
+            ContractionHierarchy<> hierarchy;
+            hierarchy.build(moved, 8);
+            for (sizeType s : sources(g.graph.get()))
+            {
+                const std::vector<int> expected = DijkstraAlgorithm::shortestPath(csr, s);
+                check(DijkstraAlgorithm::shortestPath(moved.view(), s) == expected, where + " query");
+                check(deltaStepping.shortestPath(moved, s) == expected, where + " delta-stepping");
+                for (sizeType t = 0; t < moved.sizeV(); t += 7)
+                {
+                    check(bidirectional.shortestPath(moved, s, t).distance == expected[t], where + " bidirectional");
+                    check(alt.shortestPath(moved, s, t).distance == expected[t], where + " ALT");
+                    check(hierarchy.shortestPath(s, t).distance == expected[t], where + " CH");
+                }
+            }
+        }
+    }
+
+    // Migawka CSR zapisywana jest bez elementow; ponowne otwarcie zastepuje poprzedni plik
+    const CSRGraph<int> csr = graphs.back().graph->freeze();
+    check(MappedGraph<int,int>::save(csr.view(), filePath), "mapped save CSR");
+    MappedGraph<int,int> mapped;
+    check(mapped.open(filePath) && !mapped.hasPayloads() && sameView(mapped.view(), csr.view()), "mapped reopen CSR");
+    mapped.close();
+    check(!mapped.isOpen() && mapped.sizeV() == 0 && mapped.view().sizeV() == 0 && !mapped.validate(), "mapped close");
+
+    // Odrzucanie plikow: wersja, typ wag i elementow, obciecie i granice sekcji. Polozenia pol naglowka:
+    // 0 magic, 8 version, 16 weightSize, 20 payloadSize, 24 vertices, 32 entries, 40-64 sekcje, 72 fileSize, 80 weightType
+    check(MappedGraph<int,int>::save(graphs.back().graph.get(), filePath), "mapped save");
+    const std::string data = readFile(filePath);
+    check(mapped.open(filePath), "mapped open original");
+    check(!mapped.open(filePath + ".missing") && !mapped.isOpen(), "mapped missing file");
+    check(!MappedGraph<int,float>().open(filePath), "mapped wrong weight kind");
+    check(!MappedGraph<int,long long>().open(filePath), "mapped wrong weight size");
+    check(!MappedGraph<int,std::uint32_t>().open(filePath), "mapped wrong weight signedness");
+    check(!MappedGraph<double,int>().open(filePath), "mapped wrong payload type");
+    for (sizeType size : { sizeType(0), sizeType(64), sizeType(127), sizeType(128), data.size() / 2, data.size() - 1 })
+    {
+        writeFile(patchedPath, data.substr(0, size));
+        check(!mapped.open(patchedPath) && !mapped.isOpen(), "mapped truncated to " + std::to_string(size));
+    }
+    writeFile(patchedPath, data + std::string(8, '\0'));
+    check(!mapped.open(patchedPath), "mapped extended file");
+
+    const struct { sizeType position; std::uint64_t value; bool wide; const char* what; } patches[] = {
+        { 0, 'X', false, "magic" },
+        { 8, 1, false, "old version" },
+        { 8, 3, false, "newer version" },
+        { 12, 0x04030201, false, "byte order" },
+        { 16, 8, false, "weight size" },
+        { 20, 8, false, "payload size" },
+        { 24, csr.sizeV() + 1, true, "vertex count" },
+        { 32, csr.sizeE() + 1, true, "entry count" },
+        { 32, UINT64_MAX / 2, true, "huge entry count" },
+        { 40, 0, true, "offsets inside header" },
+        { 48, 64 + 1, true, "misaligned targets" },
+        { 56, UINT64_MAX - 63, true, "weights past end" },
+        { 64, 128, true, "payloads overlapping offsets" },
+        { 72, data.size() + 64, true, "file size" },
+        { 80, 3, false, "weight kind" },
+    };
+    for (auto & p : patches)
+    {
+        if (p.wide)
+            patchFile(filePath, patchedPath, p.position, p.value);
+        else
+            patchFile(filePath, patchedPath, p.position, static_cast<std::uint32_t>(p.value));
+        check(!mapped.open(patchedPath) && !mapped.isOpen(), std::string("mapped rejects ") + p.what);
+    }
+
+    // Ostatnie przesuniecie musi byc rowne liczbie wpisow, a validate() sprawdza indeksy sasiadow
+    std::uint64_t targets, offsets;
+    std::memcpy(&offsets, &data[40], 8);
+    std::memcpy(&targets, &data[48], 8);
+    patchFile(filePath, patchedPath, offsets + 8 * csr.sizeV(), static_cast<std::uint64_t>(csr.sizeE() - 1));
+    check(!mapped.open(patchedPath), "mapped rejects last offset");
+    patchFile(filePath, patchedPath, targets, static_cast<std::uint32_t>(csr.sizeV()));
+    check(mapped.open(patchedPath) && !mapped.validate(), "mapped validate detects bad target");
+    patchFile(filePath, patchedPath, offsets + 8, static_cast<std::uint64_t>(csr.sizeE() + 1));
+    check(mapped.open(patchedPath) && !mapped.validate(), "mapped validate detects decreasing offsets");
+    mapped.close();
+    std::remove(filePath.c_str());
+    std::remove(patchedPath.c_str());
+}
+
+/// @brief Sprawdza macierz odleglosci z wielu zrodel wzgledem pojedynczych zapytan DijkstraAlgorithm.
+static bool sameRows(const std::vector<int>& matrix, const GraphADT<int,int>* graph, const std::vector<sizeType>& sources)
+{
+    const sizeType n = graph->sizeV();
+    if (matrix.size() != sources.size() * n)
+        return false;
+    for (sizeType r = 0; r < sources.size(); r++)
+    {
+        const std::vector<int> expected = DijkstraAlgorithm::shortestPath(graph, graph->vertex(sources[r]));
+        if (!std::equal(expected.begin(), expected.end(), matrix.begin() + r * n))
+            return false;
+    }
+    return true;
+}
+
+static void testMultiSource(const std::vector<TestGraph>& graphs)
+{
+    for (sizeType threads : { 1, 3, 8 })
+    {
+        ThreadPool pool(threads);
+        MultiSourceShortestPaths multiSource(pool);
+        check(multiSource.threads() == threads, "multi-source threads");
+        for (auto & g : graphs)
+        {
+            const CSRGraph<int> csr = g.graph->freeze();
+            const sizeType n = csr.sizeV();
+            // Brak zrodel, mniej zrodel niz watkow (dla malych grafow z powtorzeniami) oraz wszystkie wierzcholki
+            std::vector<std::vector<sizeType>> sourceSets = { {}, sources(g.graph.get()) };
+            if (n <= 64)
+                sourceSets.emplace_back();
+            for (sizeType i = 0; n <= 64 && i < n; i++)
+                sourceSets.back().push_back((i * 7) % n);
+
+            for (auto & list : sourceSets)
+            {
+                const std::string where = g.name + " threads=" + std::to_string(threads) + " sources=" + std::to_string(list.size());
+                std::vector<int> matrix(list.size() * n, -1);
+                multiSource.run(g.graph.get(), list, matrix.data());
+                check(sameRows(matrix, g.graph.get(), list), "multi-source GraphADT " + where);
+                std::fill(matrix.begin(), matrix.end(), -1);
+                multiSource.run<PairingHeap>(csr, list, matrix.data());
+                check(sameRows(matrix, g.graph.get(), list), "multi-source CSR pairing " + where);
+
+                // Funkcja wywolywana jest z watkow puli, kazdy wynik zapisywany jest do osobnego wiersza
+                for (bool adt : { true, false })
+                {
+                    std::fill(matrix.begin(), matrix.end(), -1);
+                    std::atomic<sizeType> calls(0);
+                    std::atomic<bool> sameSource(true);
+                    auto collect = [&](sizeType r, sizeType source, const std::vector<int>& D)
+                    {
+                        if (source != list[r] || D.size() != n)
+                            sameSource = false;
+                        std::copy(D.begin(), D.end(), matrix.begin() + r * n);
+                        calls++;
+                    };
+                    if (adt)
+                        multiSource.run(g.graph.get(), list, collect);
+                    else
+                        multiSource.run(csr.view(), list, collect);
+                    check(calls == list.size() && sameSource && sameRows(matrix, g.graph.get(), list),
+                          std::string("multi-source callback ") + (adt ? "GraphADT " : "CSR ") + where);
+                }
+            }
+            if (n <= 64)
+            {
+                std::vector<sizeType> all(n);
+                for (sizeType i = 0; i < n; i++)
+                    all[i] = i;
+                check(sameRows(multiSource.allPairs(g.graph.get()), g.graph.get(), all), "multi-source all pairs GraphADT " + g.name);
+                check(sameRows(multiSource.allPairs<QuaternaryHeap>(csr.view()), g.graph.get(), all), "multi-source all pairs CSR " + g.name);
+            }
+        }
+    }
+}
+
+int main()
+{
+    const std::vector<TestGraph> graphs = randomGraphs();
+    testShortestPathTree(graphs);
+    testDenseDijkstra(graphs);
+    testDeltaStepping(graphs);
+    testBidirectional(graphs);
+    testALT(graphs);
+    testContractionHierarchy(graphs);
+    testGraphGenerator();
+    testGraphRemovals();
+    testDynamicShortestPaths();
+    testIntegerDijkstra(graphs);
+    testGenericWeights(graphs);
+    testMultiSource(graphs);
+    testGraphLoader();
+    testMappedGraph(graphs);
+
+    if (failures)
+    {
+        std::cerr << failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}